@@ -0,0 +1,225 @@
+/*
+ * Batch.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include "Batch.h"
+#include "CompressedGraph.h"
+#include "GraphFile.h"
+#include "GraphLoader.h"
+#include "Parallel.h"
+
+// Scratch state of one worker, reused from job to job
+struct sBatchWorker {
+	sGraph graph;
+	sWorkspace workspace;
+	sMstResult result;
+};
+
+// Short name of the scheme, the same names mstbench uses
+static string schemeName(const sMstOptions& options) {
+	switch (options.scheme) {
+	case SIMPLE_SCHEME:
+		return "simple";
+	case KRUSKAL_SCHEME:
+		return options.bFilterKruskal ? "filter" : "kruskal";
+	case BORUVKA_SCHEME:
+		return "boruvka";
+	case DENSE_SCHEME:
+		return "dense";
+	default:
+		return options.strHeapName;
+	}
+}
+
+/*
+ * Reads the jobs of a manifest, see Batch.h. Stops at the first bad line.
+ */
+bool readBatchManifest(const string& fileName, vector<sBatchJob>& vJobs) {
+	ifstream file(fileName.c_str());
+	string line, word, error;
+	uint lineNumber = 0;
+
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	vJobs.clear();
+	while (getline(file, line)) {
+		lineNumber++;
+		istringstream words(line);
+		if (!(words >> word) || word[0] == '#')
+			continue;
+
+		sBatchJob job;
+		if (word == "-s")
+			job.options.scheme = SIMPLE_SCHEME;
+		else if (word == "-f")
+			job.options.scheme = HEAP_SCHEME;
+		else if (word == "-k")
+			job.options.scheme = KRUSKAL_SCHEME;
+		else if (word == "-b")
+			job.options.scheme = BORUVKA_SCHEME;
+		else if (word == "-d")
+			job.options.scheme = DENSE_SCHEME;
+		else
+			error = "expected -s, -f, -k, -b or -d";
+		if (error.empty() && !(words >> job.strFile))
+			error = "expected a graph file after " + word;
+		while (error.empty() && words >> word) {
+			if (checkSchemeOption(job.options.scheme, word, &error))
+				break;
+			if (word == "--filter")
+				job.options.bFilterKruskal = true;
+			else if (word == "--forest")
+				job.options.bForest = true;
+			else if (word == "--heap" && words >> word)
+				job.options.strHeapName = word;
+			else if (word == "--bucket-limit" && words >> word)
+				job.options.maxBucketKey = atoi(word.c_str());
+			else if (word == "--insert" && words >> word)
+				job.options.bEagerInsert = (word == "eager");
+			else
+				error = "unknown option " + word;
+		}
+		if (error.empty())
+			checkMstOptions(job.options, &error);
+		if (!error.empty()) {
+			cout << "File \"" << fileName << "\": " << error << " on line " << lineNumber << endl;
+			return EXIT_FAILURE;
+		}
+		// The batch runs jobs side by side, every job gets a single thread
+		job.options.numOfThreads = 1;
+		job.strScheme = schemeName(job.options) + (job.options.bForest ? "-forest" : "");
+		vJobs.push_back(job);
+	}
+	return EXIT_SUCCESS;
+}
+
+// Graph files are mapped, compressed and text files are decoded on the worker's own thread.
+// What the loader has to say goes to the job's messages, not between the CSV lines
+static bool loadGraph(const string& fileName, sGraph* graph, ostream& messages) {
+	if (isGraphFile(fileName))
+		return mapGraphFile(fileName, graph, messages);
+	if (isCompressedGraphFile(fileName))
+		return loadCompressedGraph(fileName, graph, messages);
+	return loadTextGraph(fileName, graph, 1, messages);
+}
+
+// Loader messages as one CSV field, a line each separated by "; "
+static string joinMessages(const string& messages) {
+	string joined;
+	istringstream lines(messages);
+	string line;
+	while (getline(lines, line)) {
+		if (line.empty())
+			continue;
+		if (!joined.empty())
+			joined += "; ";
+		joined += line;
+	}
+	return joined;
+}
+
+// Quotes a CSV field, doubling any quotes inside it
+static string quoteField(const string& field) {
+	string quoted = "\"";
+	for (size_t i = 0; i < field.size(); i++) {
+		if (field[i] == '"')
+			quoted += '"';
+		quoted += field[i];
+	}
+	return quoted + "\"";
+}
+
+/* Algorithm :
+		1.	Read every job of the manifest up front.
+		2.	Run the jobs on a work stealing pool with one worker per thread.
+			A worker keeps its graph arrays, Prim workspace and result buffer
+			from one job to the next, so a job costs little more than loading
+			its graph and solving it.
+		3.	Every finished job writes one CSV line to the results, in the order
+			the jobs finish. The job column gives the manifest order back.
+*/
+bool runBatch(const string& manifestFile, const string& resultFile, uint numOfThreads) {
+	vector<sBatchJob> vJobs;
+	struct timeval start, end;
+	long seconds, useconds;
+
+	if (readBatchManifest(manifestFile, vJobs))
+		return EXIT_FAILURE;
+	if (numOfThreads == 0)
+		numOfThreads = 1;
+	numOfThreads = (uint)min((size_t)numOfThreads, max(vJobs.size(), (size_t)1));
+
+	ofstream file;
+	if (!resultFile.empty()) {
+		file.open(resultFile.c_str(), ios::trunc);
+		if (!file.good()) {
+			cout << "Unable to open file \"" << resultFile << "\"" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+	ostream& out = resultFile.empty() ? cout : file;
+	out << BATCH_CSV_HEADER << "\n";
+
+	vector<sBatchWorker> vWorkers(numOfThreads);
+	mutex outputLock;
+	atomic<uint64_t> numOfFailed(0);
+
+	gettimeofday(&start, NULL);
+	parallelJobs(numOfThreads, vJobs.size(), [&](uint t, size_t j) {
+		const sBatchJob& job = vJobs[j];
+		sBatchWorker& worker = vWorkers[t];
+		struct timeval loadStart, loadEnd;
+		ostringstream messages;
+		bool bFailed;
+
+		gettimeofday(&loadStart, NULL);
+		bFailed = loadGraph(job.strFile, &worker.graph, messages);
+		gettimeofday(&loadEnd, NULL);
+		const long loadTime = (loadEnd.tv_sec - loadStart.tv_sec) * 1000000 + (loadEnd.tv_usec - loadStart.tv_usec);
+		if (bFailed) {
+			worker.result.clear();
+			worker.result.strError = "Unable to load the graph";
+		} else {
+			bFailed = solveMst(&worker.graph, job.options, &worker.workspace, &worker.result);
+		}
+		if (bFailed)
+			numOfFailed++;
+
+		const sMstResult& result = worker.result;
+		ostringstream line;
+		line << j << "," << quoteField(job.strFile) << "," << job.strScheme << "," << t << ","
+			 << (bFailed ? "failed" : "ok") << "," << (bFailed ? 0 : result.totalCost) << ","
+			 << (bFailed ? 0 : result.vEdges.size()) << ","
+			 << loadTime << "," << result.mtime << "," << quoteField(result.strError) << ","
+			 << quoteField(joinMessages(messages.str())) << "\n";
+		lock_guard<mutex> guard(outputLock);
+		out << line.str();
+	});
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+
+	out.flush();
+	if (!resultFile.empty()) {
+		file.close();
+		if (file.fail()) {
+			cout << "Unable to write file \"" << resultFile << "\"" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+	// Results on the standard output stay pure CSV, the summary goes to the standard error then
+	ostream& report = resultFile.empty() ? cerr : cout;
+	report << "Jobs = " << vJobs.size() << ", Failed = " << numOfFailed << ", Threads = " << numOfThreads << endl;
+	report << "Time Taken = " << ((seconds) * 1000000 + useconds) << " microseconds" << endl;
+	report << "==============================" << endl;
+
+	return numOfFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+/*
+ * Batch.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <string>
+#include <vector>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+
+#define BATCH_CSV_HEADER "job,file,scheme,worker,status,total_cost,edges,load_us,solve_us,error,messages"
+
+// One line of the manifest
+struct sBatchJob {
+	string strFile;
+	// Scheme option as written in the manifest, for the results
+	string strScheme;
+	sMstOptions options;
+};
+
+/*
+ * Manifest format, one job per line, blank lines and lines starting with #
+ * are skipped:
+ *
+ *   -s|-f|-k|-b|-d file [--heap h] [--insert lazy|eager] [--filter] [--forest]
+ *       [--bucket-limit n]
+ *
+ * The options mean the same as on the mst command line and, as there, only
+ * the schemes they shape take them. Every job runs on a single thread, the
+ * batch runs many jobs at once instead. The messages column of the results
+ * holds what loading the graph reported, dropped edges or why it failed.
+ */
+bool readBatchManifest(const string& fileName, vector<sBatchJob>& vJobs);
+bool runBatch(const string& manifestFile, const string& resultFile, uint numOfThreads);
+
+#endif /* BATCH_H_ */
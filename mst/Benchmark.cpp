@@ -0,0 +1,420 @@
+//============================================================================
+// Name        : Benchmark.cpp
+// Author      : Sagar Parmar
+// Description : Benchmark driver for mst, built by Benchmark/makefile
+//============================================================================
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "Benchmark.h"
+#include "CompressedGraph.h"
+#include "GraphFile.h"
+#include "RandomGraph.h"
+#include "Parallel.h"
+
+// Graphs of the sweep. Kept small enough for a run of a few minutes on one core
+static const sBenchCase benchCases[] = {
+	{ "uniform", 2000, 10 },
+	{ "uniform", 2000, 100 },
+	{ "uniform", 200000, 0.005 },
+	{ "ties", 200000, 0.005 },
+	{ "grid", 200000, 0 },
+};
+
+// Every scheme of mst, the text loader and the compressed graph decoder
+static const sBenchScheme benchSchemes[] = {
+	{ "simple", "-s", {}, BENCH_BINARY },
+	{ "dense", "-d", {}, BENCH_BINARY },
+	{ "fheap", "-f", {}, BENCH_BINARY },
+	{ "binary", "-f", { "--heap", "binary" }, BENCH_BINARY },
+	{ "4ary", "-f", { "--heap", "4ary" }, BENCH_BINARY },
+	{ "pairing", "-f", { "--heap", "pairing" }, BENCH_BINARY },
+	{ "lazy", "-f", { "--heap", "lazy" }, BENCH_BINARY },
+	{ "bucket", "-f", { "--heap", "bucket" }, BENCH_BINARY },
+	{ "kruskal", "-k", {}, BENCH_BINARY },
+	{ "filter", "-k", { "--filter" }, BENCH_BINARY },
+	{ "boruvka", "-b", {}, BENCH_BINARY },
+	{ "loader", "-k", {}, BENCH_TEXT },
+	{ "decoder", "-k", {}, BENCH_COMPRESSED },
+};
+
+static void printBenchHelp() {
+	cout << "mstbench [options] \t runs every scheme of mst over a sweep of graphs" << endl;
+	cout << "  --mst path      \t mst binary to run (default ./mst)" << endl;
+	cout << "  --reps n        \t timed runs per case (default 5)" << endl;
+	cout << "  --warmup n      \t untimed runs before them (default 1)" << endl;
+	cout << "  --csv file      \t write the results as CSV" << endl;
+	cout << "  --json file     \t write the results as JSON" << endl;
+	cout << "  --baseline file \t compare with a CSV written earlier, fails on a regression" << endl;
+	cout << "  --tolerance f   \t allowed slowdown of the median (default 0.5)" << endl;
+}
+
+/*
+ * Main function - runs the sweep and compares it with the baseline
+ */
+int main(int argc, char **argv) {
+	vector<string> args(argv + 1, argv + argc);
+	string strMstPath = "./mst", strCsvFile, strJsonFile, strBaselineFile;
+	uint reps = 5, warmup = 1;
+	double tolerance = 0.5;
+	stringstream ss;
+
+	for (vector<string>::iterator i = args.begin(); i != args.end(); ++i) {
+		if (*i == "-h" || *i == "--help") {
+			printBenchHelp();
+			return EXIT_SUCCESS;
+		}
+		else if (i + 1 == args.end()) {
+			printBenchHelp();
+			return EXIT_FAILURE;
+		}
+		else if (*i == "--mst")
+			strMstPath = *++i;
+		else if (*i == "--csv")
+			strCsvFile = *++i;
+		else if (*i == "--json")
+			strJsonFile = *++i;
+		else if (*i == "--baseline")
+			strBaselineFile = *++i;
+		else {
+			const string option = *i;
+			ss.str(*++i);
+			if (option == "--reps")
+				ss >> reps;
+			else if (option == "--warmup")
+				ss >> warmup;
+			else if (option == "--tolerance")
+				ss >> tolerance;
+			else {
+				printBenchHelp();
+				return EXIT_FAILURE;
+			}
+			ss.clear();
+		}
+	}
+	if (reps == 0)
+		reps = 1;
+
+	char tmpDir[] = "/tmp/mstbench.XXXXXX";
+	if (!mkdtemp(tmpDir)) {
+		cout << "Unable to create a temporary directory" << endl;
+		return EXIT_FAILURE;
+	}
+	const string strBinFile = string(tmpDir) + "/graph.bin";
+	const string strTextFile = string(tmpDir) + "/graph.txt";
+	const string strCompressedFile = string(tmpDir) + "/graph.cgr";
+	const string strInputFiles[] = { strBinFile, strTextFile, strCompressedFile };
+
+	vector<sBenchResult> vResults;
+	bool bFailed = false;
+	for (size_t c = 0; c < sizeof(benchCases) / sizeof(benchCases[0]) && !bFailed; c++) {
+		const sBenchCase& benchCase = benchCases[c];
+		uint numOfNodes = 0;
+		uint64_t numOfEdges = 0;
+		{
+			// Dropped and trimmed before mst runs, a forked child counts the
+			// pages of this process in its peak RSS until it calls exec
+			sGraph graph;
+			if (generateBenchGraph(benchCase, &graph) || writeGraphFile(strBinFile, &graph)
+					|| writeTextGraph(strTextFile, &graph) || writeCompressedGraph(strCompressedFile, &graph)) {
+				bFailed = true;
+				break;
+			}
+			numOfNodes = graph.numOfNodes;
+			numOfEdges = graph.numOfEdges;
+		}
+		malloc_trim(0);
+
+		for (size_t s = 0; s < sizeof(benchSchemes) / sizeof(benchSchemes[0]); s++) {
+			const sBenchScheme& scheme = benchSchemes[s];
+			if ((scheme.option == "-s" || scheme.option == "-d") && numOfNodes > BENCH_SIMPLE_MAX_NODES)
+				continue;
+			vector<string> vArgs;
+			vArgs.push_back(scheme.option);
+			vArgs.push_back(strInputFiles[scheme.input]);
+			vArgs.insert(vArgs.end(), scheme.args.begin(), scheme.args.end());
+			vArgs.push_back("--output");
+			vArgs.push_back("summary");
+			// The loader is timed by its own line, every scheme by Time Taken
+			const string strTimeLine = scheme.input != BENCH_BINARY ? "Load Time = " : "Time Taken = ";
+
+			sBenchResult result;
+			result.family = benchCase.family;
+			result.numOfNodes = numOfNodes;
+			result.density = benchCase.density;
+			result.numOfEdges = numOfEdges;
+			result.scheme = scheme.name;
+			result.reps = reps;
+			result.peakRssKb = 0;
+			result.totalCost = 0;
+			vector<long> vTimes;
+			for (uint r = 0; r < warmup + reps; r++) {
+				string output;
+				long peakRssKb = 0;
+				size_t timePos = string::npos, costPos = string::npos;
+				if (!runMst(strMstPath, vArgs, output, peakRssKb)) {
+					timePos = output.find(strTimeLine);
+					costPos = output.find("TotalCost = ");
+				}
+				if (timePos == string::npos || costPos == string::npos) {
+					cout << "mst " << scheme.option << " failed on " << benchCase.family << ":" << endl << output;
+					bFailed = true;
+					break;
+				}
+				if (r < warmup)
+					continue;
+				vTimes.push_back(atol(output.c_str() + timePos + strTimeLine.size()));
+				result.totalCost = atoll(output.c_str() + costPos + strlen("TotalCost = "));
+				result.peakRssKb = max(result.peakRssKb, peakRssKb);
+			}
+			if (bFailed)
+				break;
+
+			// Nearest rank percentiles
+			sort(vTimes.begin(), vTimes.end());
+			result.medianUs = vTimes[(vTimes.size() - 1) / 2];
+			result.p95Us = vTimes[(size_t)ceil(0.95 * vTimes.size()) - 1];
+			result.edgesPerSec = result.numOfEdges / (max(result.medianUs, 1L) / 1e6);
+			vResults.push_back(result);
+			cout << setw(8) << left << result.family << setw(8) << left << result.numOfNodes
+				 << setw(8) << left << result.density << setw(10) << left << result.scheme
+				 << "median " << result.medianUs << " us, p95 " << result.p95Us << " us, "
+				 << result.peakRssKb << " KB" << endl;
+		}
+	}
+	unlink(strBinFile.c_str());
+	unlink(strTextFile.c_str());
+	unlink(strCompressedFile.c_str());
+	rmdir(tmpDir);
+	if (bFailed)
+		return EXIT_FAILURE;
+
+	if (!strCsvFile.empty() && writeResultsCsv(strCsvFile, vResults))
+		return EXIT_FAILURE;
+	if (!strJsonFile.empty() && writeResultsJson(strJsonFile, vResults))
+		return EXIT_FAILURE;
+	if (!strBaselineFile.empty()) {
+		vector<sBenchResult> vBaseline;
+		if (readResultsCsv(strBaselineFile, vBaseline))
+			return EXIT_FAILURE;
+		return compareWithBaseline(vResults, vBaseline, tolerance);
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Generates the graph of a benchmark case, always from BENCH_SEED
+ */
+bool generateBenchGraph(const sBenchCase& benchCase, sGraph* graph) {
+	if (benchCase.family == "uniform" || benchCase.family == "ties") {
+		string strError;
+		if (generateRandomGraph(graph, benchCase.numOfNodes, benchCase.density, BENCH_SEED, defaultThreadCount(),
+				strError)) {
+			cout << "Unable to generate the " << benchCase.family << " graph: " << strError << endl;
+			return EXIT_FAILURE;
+		}
+		if (benchCase.family == "ties") {
+			// Both directions of an edge share a cost, so they stay equal
+			for (size_t e = 0; e < graph->vAdjCost.size(); e++)
+				graph->vAdjCost[e] = (graph->vAdjCost[e] - 1) % 8 + 1;
+			for (size_t e = 0; e < graph->vAdjCost16.size(); e++)
+				graph->vAdjCost16[e] = (graph->vAdjCost16[e] - 1) % 8 + 1;
+		}
+		return EXIT_SUCCESS;
+	}
+	else if (benchCase.family == "grid") {
+		const uint side = (uint)sqrt((double)benchCase.numOfNodes);
+		mt19937_64 rng(BENCH_SEED);
+		uniform_int_distribution<int> costs(1, MAX_COST);
+		vector<sEdge> vEdges;
+		sEdge e1;
+		for (uint r = 0; r < side; r++) {
+			for (uint c = 0; c < side; c++) {
+				e1.vertexStart = r * side + c;
+				if (c + 1 < side) {
+					e1.vertexEnd = r * side + c + 1;
+					e1.cost = costs(rng);
+					vEdges.push_back(e1);
+				}
+				if (r + 1 < side) {
+					e1.vertexEnd = (r + 1) * side + c;
+					e1.cost = costs(rng);
+					vEdges.push_back(e1);
+				}
+			}
+		}
+		buildGraph(graph, side * side, vEdges);
+		return EXIT_SUCCESS;
+	}
+	cout << "Unknown graph family \"" << benchCase.family << "\"" << endl;
+	return EXIT_FAILURE;
+}
+
+/*
+ * Writes a graph in the text format read by loadTextGraph
+ */
+bool writeTextGraph(const string& fileName, const sGraph* graph) {
+	ofstream file(fileName.c_str(), ios::trunc);
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	file << graph->numOfNodes << " " << graph->numOfEdges << "\n";
+	for (uint v = 0; v < graph->numOfNodes; v++)
+		for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++)
+			if (v < graph->adjVertex[e])
+				file << v << " " << graph->adjVertex[e] << " " << graph->cost(e) << "\n";
+	file.close();
+	if (file.fail()) {
+		cout << "Unable to write file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Runs mst with args in a child process and collects its standard output.
+ * peakRssKb is the peak resident set size of the child.
+ */
+bool runMst(const string& mstPath, const vector<string>& args, string& output, long& peakRssKb) {
+	int fds[2];
+	if (pipe(fds) != 0)
+		return EXIT_FAILURE;
+	const pid_t pid = fork();
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return EXIT_FAILURE;
+	}
+	if (pid == 0) {
+		dup2(fds[1], STDOUT_FILENO);
+		close(fds[0]);
+		close(fds[1]);
+		vector<char*> argv;
+		argv.push_back((char*)mstPath.c_str());
+		for (size_t i = 0; i < args.size(); i++)
+			argv.push_back((char*)args[i].c_str());
+		argv.push_back(NULL);
+		execv(mstPath.c_str(), &argv[0]);
+		_exit(127);
+	}
+	close(fds[1]);
+	char buffer[4096];
+	ssize_t n;
+	output.clear();
+	while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+		output.append(buffer, n);
+	close(fds[0]);
+
+	int status = 0;
+	struct rusage usage;
+	if (wait4(pid, &status, 0, &usage) != pid)
+		return EXIT_FAILURE;
+	peakRssKb = usage.ru_maxrss;
+	return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#define BENCH_CSV_HEADER "family,nodes,density,edges,scheme,reps,median_us,p95_us,edges_per_sec,peak_rss_kb,total_cost"
+
+bool writeResultsCsv(const string& fileName, const vector<sBenchResult>& vResults) {
+	ofstream file(fileName.c_str(), ios::trunc);
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	file << BENCH_CSV_HEADER << "\n";
+	for (size_t i = 0; i < vResults.size(); i++) {
+		const sBenchResult& r = vResults[i];
+		file << r.family << "," << r.numOfNodes << "," << r.density << "," << r.numOfEdges << ","
+			 << r.scheme << "," << r.reps << "," << r.medianUs << "," << r.p95Us << ","
+			 << (uint64_t)r.edgesPerSec << "," << r.peakRssKb << "," << r.totalCost << "\n";
+	}
+	file.close();
+	return file.fail() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+bool writeResultsJson(const string& fileName, const vector<sBenchResult>& vResults) {
+	ofstream file(fileName.c_str(), ios::trunc);
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	file << "[\n";
+	for (size_t i = 0; i < vResults.size(); i++) {
+		const sBenchResult& r = vResults[i];
+		file << "  {\"family\": \"" << r.family << "\", \"nodes\": " << r.numOfNodes
+			 << ", \"density\": " << r.density << ", \"edges\": " << r.numOfEdges
+			 << ", \"scheme\": \"" << r.scheme << "\", \"reps\": " << r.reps
+			 << ", \"median_us\": " << r.medianUs << ", \"p95_us\": " << r.p95Us
+			 << ", \"edges_per_sec\": " << (uint64_t)r.edgesPerSec << ", \"peak_rss_kb\": " << r.peakRssKb
+			 << ", \"total_cost\": " << r.totalCost << "}" << (i + 1 < vResults.size() ? "," : "") << "\n";
+	}
+	file << "]\n";
+	file.close();
+	return file.fail() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+bool readResultsCsv(const string& fileName, vector<sBenchResult>& vResults) {
+	ifstream file(fileName.c_str());
+	string line;
+	if (!file.good() || !getline(file, line) || line != BENCH_CSV_HEADER) {
+		cout << "Unable to read baseline \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	while (getline(file, line)) {
+		if (line.empty())
+			continue;
+		sBenchResult r;
+		replace(line.begin(), line.end(), ',', ' ');
+		stringstream fields(line);
+		fields >> r.family >> r.numOfNodes >> r.density >> r.numOfEdges >> r.scheme >> r.reps
+			   >> r.medianUs >> r.p95Us >> r.edgesPerSec >> r.peakRssKb >> r.totalCost;
+		if (fields.fail()) {
+			cout << "Malformed baseline line \"" << line << "\"" << endl;
+			return EXIT_FAILURE;
+		}
+		vResults.push_back(r);
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Fails if a median is slower than the baseline by more than tolerance
+ * (and BENCH_MIN_SLACK_US), or if a scheme found a different total cost.
+ */
+bool compareWithBaseline(const vector<sBenchResult>& vResults, const vector<sBenchResult>& vBaseline, double tolerance) {
+	bool bRegressed = false;
+	for (size_t i = 0; i < vResults.size(); i++) {
+		const sBenchResult& r = vResults[i];
+		const sBenchResult* base = NULL;
+		for (size_t j = 0; j < vBaseline.size() && !base; j++)
+			if (vBaseline[j].family == r.family && vBaseline[j].numOfNodes == r.numOfNodes
+					&& vBaseline[j].numOfEdges == r.numOfEdges && vBaseline[j].scheme == r.scheme)
+				base = &vBaseline[j];
+		if (!base) {
+			cout << "NEW        " << r.family << " " << r.numOfNodes << " " << r.scheme << endl;
+			continue;
+		}
+		if (base->totalCost != r.totalCost) {
+			cout << "WRONG COST " << r.family << " " << r.numOfNodes << " " << r.scheme << ": "
+				 << r.totalCost << ", baseline " << base->totalCost << endl;
+			bRegressed = true;
+		}
+		else if (r.medianUs > base->medianUs * (1 + tolerance) && r.medianUs - base->medianUs > BENCH_MIN_SLACK_US) {
+			cout << "REGRESSION " << r.family << " " << r.numOfNodes << " " << r.scheme << ": median "
+				 << r.medianUs << " us, baseline " << base->medianUs << " us" << endl;
+			bRegressed = true;
+		}
+	}
+	cout << (bRegressed ? "Benchmark regressed against the baseline" : "Benchmark within the baseline") << endl;
+	return bRegressed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
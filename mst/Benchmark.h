@@ -0,0 +1,72 @@
+/*
+ * Benchmark.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+
+// Seed of every benchmark graph, so runs and baselines are comparable
+#define BENCH_SEED 20131014
+// The simple and dense schemes are O(n^2) and are skipped above this many vertices
+#define BENCH_SIMPLE_MAX_NODES 20000
+// Regressions smaller than this are noise, whatever the tolerance
+#define BENCH_MIN_SLACK_US 2000
+
+// One graph of the sweep
+struct sBenchCase {
+	// uniform: random graph of the given density
+	// ties:    uniform graph with costs 1..8, lots of equal keys
+	// grid:    square grid with random costs, density is ignored
+	string family;
+	uint numOfNodes;
+	double density;
+};
+
+// Format of the graph file a bench scheme reads
+enum eBenchInput { BENCH_BINARY, BENCH_TEXT, BENCH_COMPRESSED };
+
+// One way of running mst on a graph
+struct sBenchScheme {
+	string name;
+	// mst option of the scheme (-s, -f, -k or -b), the graph file follows it
+	string option;
+	// Further arguments, like --heap binary
+	vector<string> args;
+	// Graph file the scheme runs on, the loaders of the text and compressed
+	// files are timed instead of the scheme
+	eBenchInput input;
+};
+
+// Measurements of one scheme on one graph
+struct sBenchResult {
+	string family;
+	uint numOfNodes;
+	double density;
+	uint64_t numOfEdges;
+	string scheme;
+	uint reps;
+	long medianUs;
+	long p95Us;
+	double edgesPerSec;
+	long peakRssKb;
+	int64_t totalCost;
+};
+
+bool generateBenchGraph(const sBenchCase& benchCase, sGraph* graph);
+bool writeTextGraph(const string& fileName, const sGraph* graph);
+bool runMst(const string& mstPath, const vector<string>& args, string& output, long& peakRssKb);
+bool writeResultsCsv(const string& fileName, const vector<sBenchResult>& vResults);
+bool writeResultsJson(const string& fileName, const vector<sBenchResult>& vResults);
+bool readResultsCsv(const string& fileName, vector<sBenchResult>& vResults);
+bool compareWithBaseline(const vector<sBenchResult>& vResults, const vector<sBenchResult>& vBaseline, double tolerance);
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,181 @@
+/*
+ * Boruvka.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <atomic>
+#include "Boruvka.h"
+#include "Parallel.h"
+
+// Edge of the shrinking edge list. u and v are component ids, id is the
+// position in the initial edge list and breaks ties between equal costs
+struct sBoruvkaEdge {
+	uint u;
+	uint v;
+	int cost;
+	uint64_t id;
+};
+
+// No candidate edge for a component in the current round
+#define NO_EDGE 0xFFFFFFFFFFFFFFFFULL
+
+// Strict (cost, id) order, which makes every edge weight distinct
+static inline bool isLighter(const vector<sBoruvkaEdge>& vOriginal, uint64_t a, uint64_t b) {
+	return vOriginal[a].cost < vOriginal[b].cost
+		|| (vOriginal[a].cost == vOriginal[b].cost && a < b);
+}
+
+// Lowers target to edge id if that edge is lighter, with compare-exchange
+static inline void atomicMin(atomic<uint64_t>& target, uint64_t id, const vector<sBoruvkaEdge>& vOriginal) {
+	uint64_t current = target.load(memory_order_relaxed);
+	while ((current == NO_EDGE || isLighter(vOriginal, id, current))
+			&& !target.compare_exchange_weak(current, id, memory_order_relaxed))
+		;
+}
+
+/* Algorithm :
+		1.	Every vertex is a component. Build the list of all edges.
+		2.	In parallel over the edges, find the minimum (cost, id) outgoing
+			edge of every component with an atomic compare-exchange.
+		3.	Add the minimum edges to the tree and merge their components with a
+			concurrent union-find. An edge picked by both of its components is
+			added once.
+		4.	In parallel, relabel edges with their new components and drop the
+			ones that became internal. Repeat from 2 until no edges are left.
+	The (cost, id) order makes every edge weight distinct, so the resulting
+	tree does not depend on the number of threads.
+*/
+bool generateMSTBoruvkaScheme(const sGraph* graph, uint numOfThreads, sMstResult* result) {
+	const uint numOfNodes = graph->numOfNodes;
+	struct timeval start, end;
+	long seconds, useconds;
+	// The tree with n-1 items
+	vector<sEdge>& vMstOutput = result->vEdges;
+	int64_t totalCost = 0;
+	uint rounds = 0;
+
+	if (numOfThreads == 0)
+		numOfThreads = 1;
+
+	// Start recording the time
+	gettimeofday(&start, NULL);
+
+	// Initial edge list, each undirected edge once
+	vector<sBoruvkaEdge> vEdges, vNextEdges;
+	vEdges.reserve(graph->numOfEdges);
+	for (uint v = 0; v < numOfNodes; v++) {
+		for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++) {
+			if (v < graph->adjVertex[e]) {
+				sBoruvkaEdge be = { v, graph->adjVertex[e], graph->cost(e), (uint64_t)vEdges.size() };
+				vEdges.push_back(be);
+			}
+		}
+	}
+	// Original end points and costs, indexed by edge id
+	const vector<sBoruvkaEdge> vOriginal(vEdges);
+
+	vector< atomic<uint64_t> > bestEdge(numOfNodes);
+	sConcurrentDisjointSet components(numOfNodes);
+	// Per thread results of a round, merged in thread order
+	vector< vector<uint64_t> > vPicked(numOfThreads);
+	vector< vector<uint> > vLiveRoots(numOfThreads);
+	vector< vector<sBoruvkaEdge> > vKept(numOfThreads);
+	vector<uint> vRoots;
+	vector<uint64_t> vTreeIds;
+	vRoots.reserve(numOfNodes);
+	for (uint v = 0; v < numOfNodes; v++)
+		vRoots.push_back(v);
+	vTreeIds.reserve(numOfNodes);
+
+	while (!vEdges.empty()) {
+		rounds++;
+
+		// Reset the candidates of the live components
+		parallelFor(numOfThreads, vRoots.size(), [&](uint, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+				bestEdge[vRoots[i]].store(NO_EDGE, memory_order_relaxed);
+		});
+
+		// Minimum outgoing edge of every component
+		parallelFor(numOfThreads, vEdges.size(), [&](uint, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				atomicMin(bestEdge[vEdges[i].u], vEdges[i].id, vOriginal);
+				atomicMin(bestEdge[vEdges[i].v], vEdges[i].id, vOriginal);
+			}
+		});
+
+		// Every edge that is the minimum of one of its components joins the
+		// tree. Each edge is looked at by one thread only, so an edge chosen
+		// by both components is still added once
+		parallelFor(numOfThreads, vEdges.size(), [&](uint t, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const uint64_t id = vEdges[i].id;
+				if (bestEdge[vEdges[i].u].load(memory_order_relaxed) == id ||
+						bestEdge[vEdges[i].v].load(memory_order_relaxed) == id) {
+					components.unite(vEdges[i].u, vEdges[i].v);
+					vPicked[t].push_back(vEdges[i].id);
+				}
+			}
+		});
+
+		// Relabel with the merged components, drop internal edges and roots
+		// that got merged away
+		parallelFor(numOfThreads, vEdges.size(), [&](uint t, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				sBoruvkaEdge e = vEdges[i];
+				e.u = components.find(e.u);
+				e.v = components.find(e.v);
+				if (e.u != e.v)
+					vKept[t].push_back(e);
+			}
+		});
+		parallelFor(numOfThreads, vRoots.size(), [&](uint t, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				if (components.find(vRoots[i]) == vRoots[i])
+					vLiveRoots[t].push_back(vRoots[i]);
+			}
+		});
+
+		vNextEdges.clear();
+		vRoots.clear();
+		for (uint t = 0; t < numOfThreads; t++) {
+			vNextEdges.insert(vNextEdges.end(), vKept[t].begin(), vKept[t].end());
+			vRoots.insert(vRoots.end(), vLiveRoots[t].begin(), vLiveRoots[t].end());
+			vTreeIds.insert(vTreeIds.end(), vPicked[t].begin(), vPicked[t].end());
+			vPicked[t].clear();
+			vKept[t].clear();
+			vLiveRoots[t].clear();
+		}
+		vEdges.swap(vNextEdges);
+#ifdef LOG_ON
+		cout << "Round " << rounds << ": " << vRoots.size() << " components, "
+			 << vEdges.size() << " edges left" << endl;
+#endif
+	}
+
+	// Report the tree in edge list order, independent of the thread count
+	sort(vTreeIds.begin(), vTreeIds.end());
+	vMstOutput.resize(vTreeIds.size());
+	for (size_t i = 0; i < vTreeIds.size(); i++) {
+		const sBoruvkaEdge& e = vOriginal[vTreeIds[i]];
+		vMstOutput[i].vertexStart = e.u;
+		vMstOutput[i].vertexEnd = e.v;
+		vMstOutput[i].cost = e.cost;
+		totalCost += e.cost;
+	}
+
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = totalCost;
+	result->strDetails = "Threads = " + to_string(numOfThreads) + ", Rounds = " + to_string(rounds) + "\n";
+
+	// The rounds ran out of edges with more than one component left
+	if (vMstOutput.size() + 1 < numOfNodes) {
+		result->strError = "Graph is not connected, it has no spanning tree";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
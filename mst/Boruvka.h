@@ -0,0 +1,19 @@
+/*
+ * Boruvka.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef BORUVKA_H_
+#define BORUVKA_H_
+
+#include <iostream>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+#include "DisjointSet.h"
+
+bool generateMSTBoruvkaScheme(const sGraph* graph, uint numOfThreads, sMstResult* result);
+
+#endif /* BORUVKA_H_ */
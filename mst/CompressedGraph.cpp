@@ -0,0 +1,319 @@
+/*
+ * CompressedGraph.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "CompressedGraph.h"
+
+/*
+ * Checks the magic number only, like isGraphFile
+ */
+bool isCompressedGraphFile(const string& fileName) {
+	char magic[8];
+	ifstream file(fileName.c_str(), ios::binary);
+	if (!file.read(magic, sizeof(magic)))
+		return false;
+	return memcmp(magic, COMPRESSED_GRAPH_MAGIC, sizeof(magic)) == 0;
+}
+
+static inline void appendVarint(vector<uint8_t>& vBytes, uint value) {
+	while (value >= 0x80) {
+		vBytes.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	vBytes.push_back((uint8_t)value);
+}
+
+// Appends the low costBits bits of value at bit position costBit
+static inline void appendBits(vector<uint64_t>& vWords, uint64_t& costBit, uint costBits, uint64_t value) {
+	if (!costBits)
+		return;
+	const uint shift = costBit & 63;
+	if (shift == 0)
+		vWords.push_back(0);
+	vWords.back() |= value << shift;
+	if (shift + costBits > 64)
+		vWords.push_back(value >> (64 - shift));
+	costBit += costBits;
+}
+
+/*
+ * Writes the graph in the compressed graph format. The rows are sorted on
+ * the way, the graph itself may hold them in any order.
+ */
+bool writeCompressedGraph(const string& fileName, const sGraph* graph) {
+	sCompressedGraphHeader header;
+	const uint numOfNodes = graph->numOfNodes;
+	const uint64_t numOfBlocks = ((uint64_t)numOfNodes + COMPRESSED_GRAPH_BLOCK_SIZE - 1) / COMPRESSED_GRAPH_BLOCK_SIZE;
+	int minCost = 0, maxCost = 0;
+	uint64_t numOfEdges = 0;
+
+	for (uint64_t e = 0; e < 2 * graph->numOfEdges; e++) {
+		const int cost = graph->cost(e);
+		if (e == 0 || cost < minCost)
+			minCost = cost;
+		if (e == 0 || cost > maxCost)
+			maxCost = cost;
+	}
+	uint costBits = 0;
+	while (costBits < 32 && ((uint64_t)((int64_t)maxCost - minCost) >> costBits))
+		costBits++;
+
+	vector<sCompressedBlock> vBlocks(numOfBlocks + 1);
+	vector<uint8_t> vGaps;
+	vector<uint64_t> vCosts;
+	uint64_t costBit = 0;
+	vector< pair<uint, int> > row;
+	vGaps.reserve(2 * graph->numOfEdges + numOfNodes);
+	vCosts.reserve((graph->numOfEdges * costBits + 63) / 64);
+	for (uint v = 0; v < numOfNodes; v++) {
+		if (v % COMPRESSED_GRAPH_BLOCK_SIZE == 0) {
+			vBlocks[v / COMPRESSED_GRAPH_BLOCK_SIZE].gapOffset = vGaps.size();
+			vBlocks[v / COMPRESSED_GRAPH_BLOCK_SIZE].costBitOffset = costBit;
+		}
+		row.clear();
+		for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++)
+			if (graph->adjVertex[e] > v)
+				row.push_back(make_pair(graph->adjVertex[e], graph->cost(e)));
+		// Parallel edges keep the cheapest
+		sort(row.begin(), row.end());
+		row.erase(unique(row.begin(), row.end(), [](const pair<uint, int>& a, const pair<uint, int>& b) {
+			return a.first == b.first;
+		}), row.end());
+		appendVarint(vGaps, row.size());
+		uint previous = v;
+		for (size_t i = 0; i < row.size(); i++) {
+			appendVarint(vGaps, row[i].first - previous - 1);
+			previous = row[i].first;
+			appendBits(vCosts, costBit, costBits, (uint)row[i].second - (uint)minCost);
+		}
+		numOfEdges += row.size();
+	}
+	vBlocks[numOfBlocks].gapOffset = vGaps.size();
+	vBlocks[numOfBlocks].costBitOffset = costBit;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, COMPRESSED_GRAPH_MAGIC, sizeof(header.magic));
+	header.version = COMPRESSED_GRAPH_VERSION;
+	header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+	header.numOfNodes = numOfNodes;
+	header.numOfEdges = numOfEdges;
+	header.minCost = minCost;
+	header.maxCost = maxCost;
+	header.costBits = costBits;
+	header.blockSize = COMPRESSED_GRAPH_BLOCK_SIZE;
+	header.numOfBlocks = numOfBlocks;
+	header.blocksPos = alignPos(sizeof(header));
+	header.gapPos = alignPos(header.blocksPos + vBlocks.size() * sizeof(sCompressedBlock));
+	header.gapSize = vGaps.size();
+	header.costPos = alignPos(header.gapPos + header.gapSize);
+	header.costBitSize = costBit;
+	header.fileSize = alignPos(header.costPos + vCosts.size() * sizeof(uint64_t));
+
+	ofstream file(fileName.c_str(), ios::binary | ios::trunc);
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	writeAligned(file, &header, sizeof(header));
+	writeAligned(file, vBlocks.data(), vBlocks.size() * sizeof(sCompressedBlock));
+	writeAligned(file, vGaps.data(), vGaps.size());
+	writeAligned(file, vCosts.data(), vCosts.size() * sizeof(uint64_t));
+	file.close();
+	if (file.fail()) {
+		cout << "Unable to write file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Maps a compressed graph file read-only and checks its header. The rows
+ * are decoded straight from the mapping by sRowDecoder.
+ */
+bool mapCompressedGraph(const string& fileName, sCompressedGraph* compressed, ostream& messages) {
+	struct stat st;
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		messages << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(sCompressedGraphHeader)) {
+		messages << "Compressed graph file \"" << fileName << "\" is truncated" << endl;
+		close(fd);
+		return EXIT_FAILURE;
+	}
+	void* base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) {
+		messages << "Unable to map file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	madvise(base, st.st_size, MADV_SEQUENTIAL);
+
+	const sCompressedGraphHeader* header = (const sCompressedGraphHeader*)base;
+	const char* error = NULL;
+	if (memcmp(header->magic, COMPRESSED_GRAPH_MAGIC, sizeof(header->magic)) != 0)
+		error = "is not a compressed graph file";
+	else if (header->byteOrder != GRAPH_FILE_BYTE_ORDER)
+		error = "was written on a machine with a different byte order";
+	else if (header->version != COMPRESSED_GRAPH_VERSION)
+		error = "has an unsupported version, compress it again";
+	else if (header->numOfNodes > 0xFFFFFFFEu)
+		error = "is too large for 32-bit vertex ids";
+	else if (header->costBits > 32 || header->minCost > header->maxCost || header->blockSize == 0
+			|| header->numOfBlocks != (header->numOfNodes + header->blockSize - 1) / header->blockSize
+			|| header->costBitSize != header->numOfEdges * header->costBits)
+		error = "has a corrupt header";
+	else if (header->fileSize != (uint64_t)st.st_size
+			|| header->blocksPos % GRAPH_FILE_ALIGNMENT || header->gapPos % GRAPH_FILE_ALIGNMENT
+			|| header->costPos % GRAPH_FILE_ALIGNMENT
+			|| header->blocksPos + (header->numOfBlocks + 1) * sizeof(sCompressedBlock) > header->gapPos
+			|| header->gapPos + header->gapSize > header->costPos
+			|| header->costPos + (header->costBitSize + 63) / 64 * sizeof(uint64_t) > header->fileSize)
+		error = "has a corrupt header";
+	if (error) {
+		messages << "Compressed graph file \"" << fileName << "\" " << error << endl;
+		munmap(base, st.st_size);
+		return EXIT_FAILURE;
+	}
+
+	if (compressed->mappedBase)
+		munmap(compressed->mappedBase, compressed->mappedSize);
+	compressed->mappedBase = base;
+	compressed->mappedSize = st.st_size;
+	compressed->header = header;
+	compressed->blocks = (const sCompressedBlock*)((const char*)base + header->blocksPos);
+	compressed->gaps = (const uint8_t*)base + header->gapPos;
+	compressed->costs = (const uint64_t*)((const char*)base + header->costPos);
+	const sCompressedBlock& last = compressed->blocks[header->numOfBlocks];
+	if (last.gapOffset != header->gapSize || last.costBitOffset != header->costBitSize) {
+		messages << "Compressed graph file \"" << fileName << "\" has a corrupt block index" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+sCompressedGraph::~sCompressedGraph() {
+	if (mappedBase)
+		munmap(mappedBase, mappedSize);
+}
+
+/*
+ * Goes to the start of row v: to the start of its block through the block
+ * index, then over the rows of the block before it
+ */
+void sRowDecoder::seek(const sCompressedGraph* graph, uint v) {
+	const uint blockSize = graph->header->blockSize;
+	const sCompressedBlock& block = graph->blocks[v / blockSize];
+	gap = graph->gaps + block.gapOffset;
+	costBit = block.costBitOffset;
+	for (uint u = v - v % blockSize; u < v; u++) {
+		const uint length = beginRow(u);
+		for (uint i = 0; i < length; i++)
+			readVarint();
+		costBit += (uint64_t)length * costBits;
+	}
+}
+
+// Second pass of decodeCompressedGraph, in the width of the graph's costs
+template <class Cost>
+static void scatterRows(const sCompressedGraph* compressed, vector<uint64_t>& vFill, uint* adjVertex, Cost* adjCost) {
+	const uint numOfNodes = compressed->header->numOfNodes;
+	sRowDecoder decoder(compressed);
+	uint w;
+	int cost;
+	for (uint v = 0; v < numOfNodes; v++) {
+		const uint length = decoder.beginRow(v);
+		for (uint i = 0; i < length; i++) {
+			decoder.next(&w, &cost);
+			uint64_t slot = vFill[v]++;
+			adjVertex[slot] = w;
+			adjCost[slot] = (Cost)cost;
+			slot = vFill[w]++;
+			adjVertex[slot] = v;
+			adjCost[slot] = (Cost)cost;
+		}
+	}
+}
+
+/*
+ * Builds the CSR graph from the compressed rows in two passes over them.
+ *   1. Count the degrees, checking every neighbour id on the way.
+ *   2. Scatter both directions of every edge. The rows are decoded in order
+ *      of their vertex, so every CSR row gets its neighbours below the
+ *      vertex in increasing order before the ones above it and comes out
+ *      sorted without sorting anything.
+ * The costs go into 16-bit storage when the header's cost range fits.
+ */
+bool decodeCompressedGraph(const sCompressedGraph* compressed, sGraph* graph, ostream& messages) {
+	const sCompressedGraphHeader* header = compressed->header;
+	const uint numOfNodes = header->numOfNodes;
+	const uint64_t numOfSlots = 2 * header->numOfEdges;
+	uint w;
+	int cost;
+
+	releaseGraph(graph);
+	vector<uint64_t>& offsets = graph->vOffsets;
+	offsets.assign(numOfNodes + 1, 0);
+	sRowDecoder decoder(compressed);
+	uint64_t numOfEdges = 0;
+	bool bCorrupt = false;
+	for (uint v = 0; v < numOfNodes && !bCorrupt; v++) {
+		const uint length = decoder.beginRow(v);
+		numOfEdges += length;
+		// The cost stream holds numOfEdges costs, more would read past it
+		if (numOfEdges > header->numOfEdges)
+			break;
+		offsets[v+1] += length;
+		for (uint i = 0; i < length && !bCorrupt; i++) {
+			decoder.next(&w, &cost);
+			// A neighbour at or below v means the gaps wrapped around
+			bCorrupt = w >= numOfNodes || w <= v;
+			if (!bCorrupt)
+				offsets[w+1]++;
+		}
+	}
+	if (bCorrupt || numOfEdges != header->numOfEdges || decoder.gap != compressed->gaps + header->gapSize) {
+		messages << "Compressed graph file has corrupt rows" << endl;
+		releaseGraph(graph);
+		return EXIT_FAILURE;
+	}
+	for (uint v = 0; v < numOfNodes; v++)
+		offsets[v+1] += offsets[v];
+
+	vector<uint64_t> vFill(offsets.begin(), offsets.end() - 1);
+	graph->vAdjVertex.resize(numOfSlots);
+	const bool bNarrow = header->minCost >= 0 && header->maxCost <= NARROW_COST_MAX;
+	if (bNarrow) {
+		graph->vAdjCost16.resize(numOfSlots);
+		scatterRows(compressed, vFill, graph->vAdjVertex.data(), graph->vAdjCost16.data());
+	} else {
+		graph->vAdjCost.resize(numOfSlots);
+		scatterRows(compressed, vFill, graph->vAdjVertex.data(), graph->vAdjCost.data());
+	}
+	graph->numOfNodes = numOfNodes;
+	graph->numOfEdges = header->numOfEdges;
+	graph->costType = bNarrow ? COST_UINT16 : COST_INT32;
+	attachOwnedArrays(graph);
+#ifdef LOG_ON
+	messages << "Decoded graph with " << graph->numOfNodes << " vertices and " << graph->numOfEdges << " edges" << endl;
+#endif
+	return EXIT_SUCCESS;
+}
+
+bool loadCompressedGraph(const string& fileName, sGraph* graph, ostream& messages) {
+	sCompressedGraph compressed;
+	if (mapCompressedGraph(fileName, &compressed, messages))
+		return EXIT_FAILURE;
+	return decodeCompressedGraph(&compressed, graph, messages);
+}
@@ -0,0 +1,141 @@
+/*
+ * CompressedGraph.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef COMPRESSEDGRAPH_H_
+#define COMPRESSEDGRAPH_H_
+
+#include <string>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+#include "GraphFile.h"
+
+#define COMPRESSED_GRAPH_MAGIC "MSTCGR\r\n"
+#define COMPRESSED_GRAPH_VERSION 1
+// Rows per entry of the block index
+#define COMPRESSED_GRAPH_BLOCK_SIZE 64
+
+/*
+ * Compressed graph file layout (all fields in host byte order):
+ *
+ *   sCompressedGraphHeader
+ *   blocks  sCompressedBlock[numOfBlocks+1]
+ *   gaps    uint8[gapSize]
+ *   costs   uint64[(costBitSize+63)/64]
+ *
+ * Every edge is stored once, in the row of its smaller end point. Row v
+ * holds its length and the gaps between its sorted neighbours, counted
+ * from v, as LEB128 varints less one, in the gap stream. The costs of the
+ * row follow each other in the cost stream as cost-minCost in costBits
+ * bits, least significant bit first. Entry b of the block index gives where
+ * row b*COMPRESSED_GRAPH_BLOCK_SIZE starts in both streams, so a row is
+ * found without decoding the rows of the blocks before it. The arrays are
+ * aligned to GRAPH_FILE_ALIGNMENT like in a binary graph file.
+ */
+struct sCompressedGraphHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t numOfNodes;
+	uint64_t numOfEdges;
+	int32_t minCost;
+	int32_t maxCost;
+	uint32_t costBits;
+	uint32_t blockSize;
+	uint64_t numOfBlocks;
+	uint64_t blocksPos;
+	uint64_t gapPos;
+	uint64_t gapSize;
+	uint64_t costPos;
+	uint64_t costBitSize;
+	uint64_t fileSize;
+};
+
+// Where the rows of a block start in the gap and cost streams
+struct sCompressedBlock {
+	uint64_t gapOffset;
+	uint64_t costBitOffset;
+};
+
+// Mapped compressed graph file
+struct sCompressedGraph {
+	const sCompressedGraphHeader* header;
+	const sCompressedBlock* blocks;
+	const uint8_t* gaps;
+	const uint64_t* costs;
+	void* mappedBase;
+	size_t mappedSize;
+
+	sCompressedGraph():
+		header(NULL),blocks(NULL),gaps(NULL),costs(NULL),mappedBase(NULL),mappedSize(0) {}
+
+	~sCompressedGraph();
+
+private:
+	sCompressedGraph(const sCompressedGraph&);
+	sCompressedGraph& operator=(const sCompressedGraph&);
+};
+
+/*
+ * Streaming decoder over the rows of a compressed graph. seek() goes to the
+ * start of a row through the block index, after that the rows are read in
+ * order: beginRow(v) returns the number of neighbours above v and next()
+ * gives them one by one in increasing order with their costs.
+ */
+struct sRowDecoder {
+	const uint8_t* gap;
+	const uint64_t* costs;
+	uint64_t costBit;
+	uint costBits;
+	int minCost;
+	// Last neighbour returned, the row's vertex at its start
+	uint neighbour;
+
+	explicit sRowDecoder(const sCompressedGraph* graph):
+		gap(graph->gaps),costs(graph->costs),costBit(0),costBits(graph->header->costBits),
+		minCost(graph->header->minCost),neighbour(0) {}
+
+	inline uint readVarint() {
+		uint value = 0;
+		for (uint shift = 0; ; shift += 7) {
+			const uint8_t byte = *gap++;
+			value |= (uint)(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+	}
+
+	void seek(const sCompressedGraph* graph, uint v);
+
+	inline uint beginRow(uint v) {
+		neighbour = v;
+		return readVarint();
+	}
+
+	inline void next(uint* w, int* cost) {
+		neighbour += readVarint() + 1;
+		*w = neighbour;
+		uint64_t bits = 0;
+		if (costBits) {
+			const uint shift = costBit & 63;
+			bits = costs[costBit >> 6] >> shift;
+			if (shift + costBits > 64)
+				bits |= costs[(costBit >> 6) + 1] << (64 - shift);
+			bits &= ((uint64_t)1 << costBits) - 1;
+			costBit += costBits;
+		}
+		*cost = (int)((uint)minCost + (uint)bits);
+	}
+};
+
+bool isCompressedGraphFile(const string& fileName);
+bool writeCompressedGraph(const string& fileName, const sGraph* graph);
+bool mapCompressedGraph(const string& fileName, sCompressedGraph* compressed, ostream& messages);
+bool decodeCompressedGraph(const sCompressedGraph* compressed, sGraph* graph, ostream& messages);
+bool loadCompressedGraph(const string& fileName, sGraph* graph, ostream& messages);
+
+#endif /* COMPRESSEDGRAPH_H_ */
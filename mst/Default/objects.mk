@@ -4,5 +4,8 @@
 
 USER_OBJS :=
 
-LIBS :=
+# The command line front end, everything else goes into libmst.a
+CLI_OBJS := ./Batch.o ./Mst.o ./MstOutput.o
+
+LIBS := -lpthread
 
@@ -4,23 +4,71 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../Batch.cpp \
+../Boruvka.cpp \
+../CompressedGraph.cpp \
+../DensePrim.cpp \
+../DynamicMst.cpp \
+../ExternalMst.cpp \
+../Graph.cpp \
+../GraphFile.cpp \
+../GraphLoader.cpp \
+../Kruskal.cpp \
 ../Mst.cpp \
-../RandomGraph.cpp 
+../MstOutput.cpp \
+../MstSolver.cpp \
+../RandomGraph.cpp \
+../Reorder.cpp \
+../ResultCache.cpp \
+../SpanningForest.cpp \
+../Verifier.cpp 
 
 OBJS += \
+./Batch.o \
+./Boruvka.o \
+./CompressedGraph.o \
+./DensePrim.o \
+./DynamicMst.o \
+./ExternalMst.o \
+./Graph.o \
+./GraphFile.o \
+./GraphLoader.o \
+./Kruskal.o \
 ./Mst.o \
-./RandomGraph.o 
+./MstOutput.o \
+./MstSolver.o \
+./RandomGraph.o \
+./Reorder.o \
+./ResultCache.o \
+./SpanningForest.o \
+./Verifier.o 
 
 CPP_DEPS += \
+./Batch.d \
+./Boruvka.d \
+./CompressedGraph.d \
+./DensePrim.d \
+./DynamicMst.d \
+./ExternalMst.d \
+./Graph.d \
+./GraphFile.d \
+./GraphLoader.d \
+./Kruskal.d \
 ./Mst.d \
-./RandomGraph.d 
+./MstOutput.d \
+./MstSolver.d \
+./RandomGraph.d \
+./Reorder.d \
+./ResultCache.d \
+./SpanningForest.d \
+./Verifier.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 %.o: ../%.cpp
 	@echo 'Building file: $<'
 	@echo 'Invoking: GCC C++ Compiler'
-	g++ -O2 -g -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	g++ -std=gnu++17 -O2 -g -Wall -pthread -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -0,0 +1,266 @@
+/*
+ * DensePrim.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <memory>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "DensePrim.h"
+#include "Parallel.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Lightest key of a range of vertices, lowest vertex id among equal keys
+struct sDenseMin {
+	int key;
+	uint vertex;
+};
+
+// Relaxes keys[begin, end) with the row of the vertex u that just joined
+// the tree and returns the lightest key of the range
+typedef sDenseMin (*DenseSweep)(const int* row, int* keys, uint* parents, uint u, uint begin, uint end);
+
+static sDenseMin sweepScalar(const int* row, int* keys, uint* parents, uint u, uint begin, uint end) {
+	sDenseMin best = { DENSE_DONE, begin };
+	for (uint w = begin; w < end; w++) {
+		int k = keys[w];
+		if (row[w] < k && k != DENSE_DONE) {
+			k = row[w];
+			keys[w] = k;
+			parents[w] = u;
+		}
+		if (k < best.key) {
+			best.key = k;
+			best.vertex = w;
+		}
+	}
+	return best;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Picks the lightest lane, lowest vertex id among equal keys
+static inline sDenseMin reduceLanes(const int* minKeys, const uint* minIds, uint lanes, uint begin) {
+	sDenseMin best = { DENSE_DONE, begin };
+	for (uint l = 0; l < lanes; l++)
+		if (minKeys[l] < best.key || (minKeys[l] == best.key && minIds[l] < best.vertex)) {
+			best.key = minKeys[l];
+			best.vertex = minIds[l];
+		}
+	return best;
+}
+
+/*
+ * Same as sweepScalar, 8 vertices at a time. A key is lowered where the row
+ * is lighter and the vertex isn't done, and every lane keeps the first
+ * lightest key it has seen together with its vertex id.
+ */
+__attribute__((target("avx2")))
+static sDenseMin sweepAvx2(const int* row, int* keys, uint* parents, uint u, uint begin, uint end) {
+	const __m256i done = _mm256_set1_epi32(DENSE_DONE);
+	const __m256i from = _mm256_set1_epi32(u);
+	const __m256i step = _mm256_set1_epi32(8);
+	__m256i ids = _mm256_add_epi32(_mm256_set1_epi32(begin), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+	__m256i minKeys = done, minIds = ids;
+
+	for (uint w = begin; w < end; w += 8) {
+		__m256i k = _mm256_loadu_si256((const __m256i*)(keys + w));
+		const __m256i c = _mm256_loadu_si256((const __m256i*)(row + w));
+		const __m256i lower = _mm256_andnot_si256(_mm256_cmpeq_epi32(k, done), _mm256_cmpgt_epi32(k, c));
+		if (!_mm256_testz_si256(lower, lower)) {
+			const __m256i p = _mm256_loadu_si256((const __m256i*)(parents + w));
+			k = _mm256_blendv_epi8(k, c, lower);
+			_mm256_storeu_si256((__m256i*)(keys + w), k);
+			_mm256_storeu_si256((__m256i*)(parents + w), _mm256_blendv_epi8(p, from, lower));
+		}
+		const __m256i better = _mm256_cmpgt_epi32(minKeys, k);
+		minKeys = _mm256_min_epi32(minKeys, k);
+		minIds = _mm256_blendv_epi8(minIds, ids, better);
+		ids = _mm256_add_epi32(ids, step);
+	}
+	int laneKeys[8];
+	uint laneIds[8];
+	_mm256_storeu_si256((__m256i*)laneKeys, minKeys);
+	_mm256_storeu_si256((__m256i*)laneIds, minIds);
+	return reduceLanes(laneKeys, laneIds, 8, begin);
+}
+
+// sweepAvx2 with 4 lanes, for CPUs without AVX2
+__attribute__((target("sse4.1")))
+static sDenseMin sweepSse41(const int* row, int* keys, uint* parents, uint u, uint begin, uint end) {
+	const __m128i done = _mm_set1_epi32(DENSE_DONE);
+	const __m128i from = _mm_set1_epi32(u);
+	const __m128i step = _mm_set1_epi32(4);
+	__m128i ids = _mm_add_epi32(_mm_set1_epi32(begin), _mm_setr_epi32(0, 1, 2, 3));
+	__m128i minKeys = done, minIds = ids;
+
+	for (uint w = begin; w < end; w += 4) {
+		__m128i k = _mm_loadu_si128((const __m128i*)(keys + w));
+		const __m128i c = _mm_loadu_si128((const __m128i*)(row + w));
+		const __m128i lower = _mm_andnot_si128(_mm_cmpeq_epi32(k, done), _mm_cmpgt_epi32(k, c));
+		if (!_mm_testz_si128(lower, lower)) {
+			const __m128i p = _mm_loadu_si128((const __m128i*)(parents + w));
+			k = _mm_blendv_epi8(k, c, lower);
+			_mm_storeu_si128((__m128i*)(keys + w), k);
+			_mm_storeu_si128((__m128i*)(parents + w), _mm_blendv_epi8(p, from, lower));
+		}
+		const __m128i better = _mm_cmpgt_epi32(minKeys, k);
+		minKeys = _mm_min_epi32(minKeys, k);
+		minIds = _mm_blendv_epi8(minIds, ids, better);
+		ids = _mm_add_epi32(ids, step);
+	}
+	int laneKeys[4];
+	uint laneIds[4];
+	_mm_storeu_si128((__m128i*)laneKeys, minKeys);
+	_mm_storeu_si128((__m128i*)laneIds, minIds);
+	return reduceLanes(laneKeys, laneIds, 4, begin);
+}
+#endif
+
+// Widest sweep the CPU supports, with its name for the report
+static DenseSweep selectSweep(const char** name) {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		*name = "avx2";
+		return sweepAvx2;
+	}
+	if (__builtin_cpu_supports("sse4.1")) {
+		*name = "sse4.1";
+		return sweepSse41;
+	}
+#endif
+	*name = "scalar";
+	return sweepScalar;
+}
+
+/* Algorithm :
+		1.	Store the costs in an n x n matrix, a missing edge costs DENSE_INF.
+		2.	Keep one key per vertex, DENSE_DONE once it's in the tree.
+		3.	Repeatedly add the vertex u with the lightest key and sweep row u once,
+			lowering the keys of the other vertices and finding the next lightest
+			key in the same pass.
+	Each thread sweeps its own slice of the vertices and the slices are
+	combined between two barriers per step.
+*/
+bool generateMSTDenseScheme(const sGraph* graph, uint numOfThreads, sMstResult* result) {
+	const uint numOfNodes = graph->numOfNodes;
+	// Row length, padded with done vertices to whole vectors
+	const uint stride = (numOfNodes + DENSE_LANES - 1) / DENSE_LANES * DENSE_LANES;
+	struct timeval start, end;
+	long seconds, useconds;
+	const char* sweepName = "";
+	const DenseSweep sweep = selectSweep(&sweepName);
+
+	if (numOfNodes == 0) {
+		result->strError = "Graph has no vertices";
+		return EXIT_FAILURE;
+	}
+	const uint64_t matrixBytes = (uint64_t)stride * numOfNodes * sizeof(int);
+	if (matrixBytes > (uint64_t)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE) / 2) {
+		result->strError = "Dense scheme needs a " + to_string(matrixBytes >> 20) + " MB cost matrix, "
+			"more than half of the memory. Use -f or -k for this graph";
+		return EXIT_FAILURE;
+	}
+	if (numOfNodes < DENSE_PARALLEL_MIN_NODES || numOfThreads == 0)
+		numOfThreads = 1;
+	numOfThreads = min(numOfThreads, stride / DENSE_LANES);
+
+	gettimeofday(&start, NULL);
+
+	// Cost matrix, filled row by row from the adjacency lists. Left
+	// uninitialised, every row is written once below, and backed by huge
+	// pages where the kernel allows it to save most of the page faults
+	const size_t matrixSize = (matrixBytes + DENSE_PAGE_SIZE - 1) / DENSE_PAGE_SIZE * DENSE_PAGE_SIZE;
+	unique_ptr<int, void (*)(void*)> vMatrix((int*)aligned_alloc(DENSE_PAGE_SIZE, matrixSize), free);
+	if (!vMatrix) {
+		result->strError = "Unable to allocate the cost matrix";
+		return EXIT_FAILURE;
+	}
+	madvise(vMatrix.get(), matrixSize, MADV_HUGEPAGE);
+	// Heaviest cost each thread wrote, see the check below
+	vector<int> vMaxCost(numOfThreads, INT_MIN);
+	parallelFor(numOfThreads, numOfNodes, [&](uint t, size_t begin, size_t end) {
+		int maxCost = INT_MIN;
+		for (size_t v = begin; v < end; v++) {
+			int* row = vMatrix.get() + v * stride;
+			fill(row, row + stride, (int)DENSE_INF);
+			for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++) {
+				const int cost = graph->cost(e);
+				row[graph->adjVertex[e]] = min(row[graph->adjVertex[e]], cost);
+				maxCost = max(maxCost, cost);
+			}
+		}
+		vMaxCost[t] = maxCost;
+	});
+	// DENSE_INF and DENSE_DONE share the cost range, an edge that heavy
+	// would read as a missing edge or a vertex in the tree
+	if (*max_element(vMaxCost.begin(), vMaxCost.end()) >= DENSE_INF) {
+		result->strError = "Dense scheme takes costs below " + to_string(DENSE_INF) + ". Use -f or -k for this graph";
+		return EXIT_FAILURE;
+	}
+
+	struct timeval built;
+	gettimeofday(&built, NULL);
+	vector<int> vKeys(stride, DENSE_INF);
+	vector<uint> vParentIds(stride, 0);
+	// The tree, vMstOutput[step-1] is the edge added in that step
+	vector<sEdge>& vMstOutput = result->vEdges;
+	vMstOutput.resize(numOfNodes - 1);
+	vector<sDenseMin> vBest(numOfThreads);
+	sSpinBarrier barrier(numOfThreads);
+	for (uint v = numOfNodes; v < stride; v++)
+		vKeys[v] = DENSE_DONE;
+	// Root joins the tree first
+	vKeys[0] = DENSE_DONE;
+	uint current = 0;
+	int64_t totalCost = 0;
+	bool bDisconnected = false;
+
+	parallelRun(numOfThreads, [&](uint t) {
+		const uint begin = (uint)((uint64_t)stride / DENSE_LANES * t / numOfThreads) * DENSE_LANES;
+		const uint end = (uint)((uint64_t)stride / DENSE_LANES * (t + 1) / numOfThreads) * DENSE_LANES;
+		for (uint step = 1; step < numOfNodes; step++) {
+			const uint u = current;
+			vBest[t] = sweep(vMatrix.get() + (size_t)u * stride, &vKeys[0], &vParentIds[0], u, begin, end);
+			barrier.wait();
+			if (t == 0) {
+				sDenseMin best = vBest[0];
+				for (uint i = 1; i < numOfThreads; i++)
+					if (vBest[i].key < best.key)
+						best = vBest[i];
+				if (best.key >= DENSE_INF) {
+					bDisconnected = true;
+				} else {
+					vKeys[best.vertex] = DENSE_DONE;
+					vMstOutput[step-1].vertexStart = vParentIds[best.vertex];
+					vMstOutput[step-1].vertexEnd = best.vertex;
+					vMstOutput[step-1].cost = best.key;
+					totalCost += best.key;
+					current = best.vertex;
+				}
+			}
+			barrier.wait();
+			if (bDisconnected)
+				break;
+		}
+	});
+
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = totalCost;
+
+	if (bDisconnected) {
+		result->strError = "Graph is not connected, it has no spanning tree";
+		return EXIT_FAILURE;
+	}
+	result->strDetails = "Threads = " + to_string(numOfThreads) + ", Sweep = " + sweepName + ", Matrix Time = "
+		+ to_string((built.tv_sec - start.tv_sec) * 1000000 + (built.tv_usec - start.tv_usec)) + " microseconds\n";
+
+	return EXIT_SUCCESS;
+}
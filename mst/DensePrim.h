@@ -0,0 +1,31 @@
+/*
+ * DensePrim.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef DENSEPRIM_H_
+#define DENSEPRIM_H_
+
+#include <iostream>
+#include <climits>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+
+// Key of a vertex already in the tree, never lowered and never picked
+#define DENSE_DONE INT_MAX
+// Key of a vertex not reached yet, and cost of a missing edge. The scheme
+// rejects graphs with costs of DENSE_INF or more, they would read as these
+#define DENSE_INF (INT_MAX - 1)
+// Rows and the key array are padded to a whole number of AVX2 vectors
+#define DENSE_LANES 8
+// The cost matrix is aligned to huge pages
+#define DENSE_PAGE_SIZE (1 << 21)
+// Below this many vertices a step is too short to split across threads
+#define DENSE_PARALLEL_MIN_NODES 4096
+
+bool generateMSTDenseScheme(const sGraph* graph, uint numOfThreads, sMstResult* result);
+
+#endif /* DENSEPRIM_H_ */
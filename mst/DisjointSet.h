@@ -0,0 +1,104 @@
+/*
+ * DisjointSet.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef DISJOINTSET_H_
+#define DISJOINTSET_H_
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+/*
+ * Union-find over vertices 0..n-1 with union by rank and path compression
+ * (path halving, which needs no recursion and no second pass).
+ */
+struct sDisjointSet {
+	vector<uint> parent;
+	vector<uint8_t> rank;
+
+	sDisjointSet() {}
+	explicit sDisjointSet(uint n) { reset(n); }
+
+	// Every vertex becomes its own set
+	void reset(uint n) {
+		parent.resize(n);
+		rank.assign(n, 0);
+		for (uint i = 0; i < n; i++)
+			parent[i] = i;
+	}
+
+	inline uint find(uint v) {
+		while (parent[v] != v) {
+			parent[v] = parent[parent[v]];
+			v = parent[v];
+		}
+		return v;
+	}
+
+	// Merges the sets of a and b. Returns false if they were already joined
+	inline bool unite(uint a, uint b) {
+		a = find(a);
+		b = find(b);
+		if (a == b)
+			return false;
+		if (rank[a] < rank[b])
+			swap(a, b);
+		parent[b] = a;
+		if (rank[a] == rank[b])
+			rank[a]++;
+		return true;
+	}
+};
+
+/*
+ * Lock free union-find that several threads may use at once. Roots are
+ * linked by id (the larger root goes under the smaller one), so the final
+ * partition and its representatives do not depend on thread timing.
+ * Path halving is best effort: a lost compare-exchange only skips a shortcut.
+ */
+struct sConcurrentDisjointSet {
+	vector< atomic<uint> > parent;
+
+	explicit sConcurrentDisjointSet(uint n):
+		parent(n) {
+		for (uint i = 0; i < n; i++)
+			parent[i].store(i, memory_order_relaxed);
+	}
+
+	inline uint find(uint v) {
+		uint p = parent[v].load(memory_order_relaxed);
+		while (p != v) {
+			uint gp = parent[p].load(memory_order_relaxed);
+			if (gp != p)
+				parent[v].compare_exchange_weak(p, gp, memory_order_relaxed);
+			v = p;
+			p = parent[v].load(memory_order_relaxed);
+		}
+		return v;
+	}
+
+	// Merges the sets of a and b. Returns false if they were already joined
+	bool unite(uint a, uint b) {
+		while (true) {
+			a = find(a);
+			b = find(b);
+			if (a == b)
+				return false;
+			if (a > b)
+				swap(a, b);
+			// Hook root b under a, retry if b stopped being a root meanwhile
+			uint expected = b;
+			if (parent[b].compare_exchange_strong(expected, a))
+				return true;
+		}
+	}
+};
+
+#endif /* DISJOINTSET_H_ */
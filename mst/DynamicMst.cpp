@@ -0,0 +1,454 @@
+/*
+ * DynamicMst.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "DynamicMst.h"
+
+// No replacement edge across a cut
+#define NO_EDGE 0xFFFFFFFFu
+
+// Link-cut tree nodes: vertices first, then one node per edge id
+static inline uint vertexNode(uint v) {
+	return v + 1;
+}
+
+static inline uint edgeNode(const sDynamicMst* mst, uint e) {
+	return mst->numOfNodes + 1 + e;
+}
+
+// Strict (cost, id) order of the edges as a link-cut tree key. Vertex
+// nodes keep key 0, below every edge
+static inline uint64_t treeKey(const sDynamicMst* mst, uint e) {
+	return ((uint64_t)((uint)mst->vEdges[e].cost ^ 0x80000000u) << 32 | e) + 1;
+}
+
+static string edgeName(const sDeltaOp& delta) {
+	return "Edge " + to_string(delta.u) + " " + to_string(delta.v);
+}
+
+/*
+ * Reads the changes of a delta file, see DynamicMst.h
+ */
+bool readDeltaFile(const string& fileName, uint numOfNodes, vector<sDeltaOp>& vOps) {
+	ifstream file(fileName.c_str());
+	string line, op;
+	uint lineNumber = 0;
+
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	vOps.clear();
+	while (getline(file, line)) {
+		lineNumber++;
+		istringstream words(line);
+		if (!(words >> op) || op[0] == '#')
+			continue;
+		sDeltaOp delta;
+		delta.cost = 0;
+		bool bValid = op.size() == 1 && (words >> delta.u >> delta.v);
+		if (bValid && op == "+")
+			delta.op = DELTA_INSERT;
+		else if (bValid && op == "-")
+			delta.op = DELTA_DELETE;
+		else if (bValid && op == "=")
+			delta.op = DELTA_CHANGE;
+		else
+			bValid = false;
+		if (bValid && delta.op != DELTA_DELETE)
+			bValid = (bool)(words >> delta.cost);
+		if (!bValid || delta.u >= numOfNodes || delta.v >= numOfNodes || delta.u == delta.v) {
+			cout << "File \"" << fileName << "\": expected \"+ u v cost\", \"- u v\" or \"= u v cost\" "
+				 << "with two different vertices below " << numOfNodes << " on line " << lineNumber << endl;
+			return EXIT_FAILURE;
+		}
+		vOps.push_back(delta);
+	}
+	return EXIT_SUCCESS;
+}
+
+// Remembers the state of edge e before the first change of this batch
+static void touchEdge(sDynamicMst* mst, uint e) {
+	sDynamicEdge& edge = mst->vEdges[e];
+	if (edge.batch != mst->batch) {
+		edge.batch = mst->batch;
+		edge.bWasTree = edge.bAlive && edge.bTree;
+		edge.wasCost = edge.cost;
+		mst->vTouched.push_back(e);
+	}
+}
+
+static void addToTree(sDynamicMst* mst, uint e) {
+	sDynamicEdge& edge = mst->vEdges[e];
+	const uint node = edgeNode(mst, e);
+	mst->tree.setKey(node, treeKey(mst, e));
+	mst->tree.link(vertexNode(edge.u), node);
+	mst->tree.link(node, vertexNode(edge.v));
+	edge.bTree = true;
+	mst->totalCost += edge.cost;
+}
+
+static void removeFromTree(sDynamicMst* mst, uint e) {
+	sDynamicEdge& edge = mst->vEdges[e];
+	const uint node = edgeNode(mst, e);
+	mst->tree.cut(vertexNode(edge.u), node);
+	mst->tree.cut(node, vertexNode(edge.v));
+	edge.bTree = false;
+	mst->totalCost -= edge.cost;
+}
+
+// Adds a new edge to the adjacency of both end points and returns its id
+static uint newEdge(sDynamicMst* mst, uint u, uint v, int cost) {
+	uint e;
+	if (!mst->vFreeIds.empty()) {
+		e = mst->vFreeIds.back();
+		mst->vFreeIds.pop_back();
+	} else {
+		e = mst->vEdges.size();
+		mst->vEdges.push_back(sDynamicEdge());
+		mst->tree.resize(mst->numOfNodes + mst->vEdges.size());
+	}
+	sDynamicEdge& edge = mst->vEdges[e];
+	edge.u = u;
+	edge.v = v;
+	edge.cost = cost;
+	edge.bTree = false;
+	edge.bAlive = true;
+	edge.batch = 0;
+	edge.posU = mst->vAdjacency[u].size();
+	mst->vAdjacency[u].push_back(e);
+	edge.posV = mst->vAdjacency[v].size();
+	mst->vAdjacency[v].push_back(e);
+	return e;
+}
+
+// Id of the edge u-v, found in the adjacency of the end point with the
+// lower degree, NO_EDGE if there is none
+static uint findEdge(const sDynamicMst* mst, uint u, uint v) {
+	if (mst->vAdjacency[u].size() > mst->vAdjacency[v].size())
+		swap(u, v);
+	const vector<uint>& adjacency = mst->vAdjacency[u];
+	for (size_t i = 0; i < adjacency.size(); i++) {
+		const sDynamicEdge& edge = mst->vEdges[adjacency[i]];
+		if (edge.u == v || edge.v == v)
+			return adjacency[i];
+	}
+	return NO_EDGE;
+}
+
+// Takes edge e out of the adjacency of vertex w, the last edge fills its slot
+static void unlinkAdjacency(sDynamicMst* mst, uint e, uint w) {
+	vector<uint>& adjacency = mst->vAdjacency[w];
+	const uint pos = (mst->vEdges[e].u == w) ? mst->vEdges[e].posU : mst->vEdges[e].posV;
+	const uint moved = adjacency.back();
+	adjacency[pos] = moved;
+	adjacency.pop_back();
+	if (mst->vEdges[moved].u == w)
+		mst->vEdges[moved].posU = pos;
+	else
+		mst->vEdges[moved].posV = pos;
+}
+
+static void deleteEdge(sDynamicMst* mst, uint e) {
+	sDynamicEdge& edge = mst->vEdges[e];
+	unlinkAdjacency(mst, e, edge.u);
+	unlinkAdjacency(mst, e, edge.v);
+	edge.bAlive = false;
+	mst->vDeadIds.push_back(e);
+}
+
+/*
+ * Cycle property: non-tree edge e joins the tree if its end points are in
+ * different trees, or in place of the heaviest edge on the tree path
+ * between them if that edge is heavier than e
+ */
+static void offerEdge(sDynamicMst* mst, uint e) {
+	const uint heaviest = mst->tree.pathMax(vertexNode(mst->vEdges[e].u), vertexNode(mst->vEdges[e].v));
+	if (heaviest == 0) {
+		addToTree(mst, e);
+		mst->numOfComponents--;
+	} else if (mst->tree.keys[heaviest] > treeKey(mst, e)) {
+		const uint f = heaviest - edgeNode(mst, 0);
+		touchEdge(mst, f);
+		removeFromTree(mst, f);
+		addToTree(mst, e);
+	}
+}
+
+/*
+ * Cut property: after a tree edge between a and b was removed, the lightest
+ * edge between the two halves reconnects them. Both halves are walked along
+ * their tree edges at once, one adjacency slot per side in turn, and the
+ * side that is exhausted first is the smaller one. Non-tree edges of that
+ * side leaving it are the candidates. A non-tree edge never joins two trees
+ * of the forest, so every one of them leads to the other half.
+ */
+static uint findReplacement(sDynamicMst* mst, uint a, uint b) {
+	if (mst->stamp >= 0xFFFFFFFFu - 2) {
+		mst->vStamps.assign(mst->numOfNodes, 0);
+		mst->stamp = 0;
+	}
+	const uint sideStamp[2] = { mst->stamp + 1, mst->stamp + 2 };
+	mst->stamp += 2;
+	vector<uint>* vQueue = mst->vQueue;
+	vector<uint>* vCandidates = mst->vCandidates;
+	size_t head[2] = { 0, 0 }, pos[2] = { 0, 0 };
+	const uint start[2] = { a, b };
+	for (uint s = 0; s < 2; s++) {
+		vQueue[s].clear();
+		vCandidates[s].clear();
+		vQueue[s].push_back(start[s]);
+		mst->vStamps[start[s]] = sideStamp[s];
+	}
+
+	for (uint s = 0; ; s ^= 1) {
+		// Next adjacency slot of side s, moving on to the next queued vertex
+		while (head[s] < vQueue[s].size() && pos[s] == mst->vAdjacency[vQueue[s][head[s]]].size()) {
+			head[s]++;
+			pos[s] = 0;
+		}
+		if (head[s] == vQueue[s].size()) {
+			uint best = NO_EDGE;
+			for (size_t i = 0; i < vCandidates[s].size(); i++) {
+				const uint e = vCandidates[s][i];
+				const sDynamicEdge& edge = mst->vEdges[e];
+				if (mst->vStamps[edge.u] == sideStamp[s] && mst->vStamps[edge.v] == sideStamp[s])
+					continue;
+				if (best == NO_EDGE || treeKey(mst, e) < treeKey(mst, best))
+					best = e;
+			}
+			return best;
+		}
+		const uint w = vQueue[s][head[s]];
+		const uint e = mst->vAdjacency[w][pos[s]++];
+		const sDynamicEdge& edge = mst->vEdges[e];
+		if (edge.bTree) {
+			const uint other = (edge.u == w) ? edge.v : edge.u;
+			if (mst->vStamps[other] != sideStamp[s]) {
+				mst->vStamps[other] = sideStamp[s];
+				vQueue[s].push_back(other);
+			}
+		} else {
+			vCandidates[s].push_back(e);
+		}
+	}
+}
+
+// Reconnects the two halves left by removing a tree edge between u and v
+static void replaceTreeEdge(sDynamicMst* mst, uint u, uint v) {
+	const uint e = findReplacement(mst, u, v);
+	if (e == NO_EDGE) {
+		mst->numOfComponents++;
+		return;
+	}
+	touchEdge(mst, e);
+	addToTree(mst, e);
+}
+
+/*
+ * Builds the dynamic graph from the CSR graph, which has no parallel
+ * edges, and the tree a scheme found for it. The link-cut tree is built
+ * directly from a heavy path decomposition of the MST, in O(n) instead of
+ * one link per tree edge.
+ */
+void buildDynamicMst(const sGraph* graph, const sMstResult& result, sDynamicMst* mst) {
+	const uint numOfNodes = graph->numOfNodes;
+	mst->numOfNodes = numOfNodes;
+	mst->vEdges.clear();
+	mst->vEdges.reserve(graph->numOfEdges);
+	mst->vAdjacency.assign(numOfNodes, vector<uint>());
+	mst->vFreeIds.clear();
+	mst->vDeadIds.clear();
+	mst->vTouched.clear();
+	mst->vStamps.assign(numOfNodes, 0);
+	mst->batch = 0;
+	mst->tree = sLinkCutTree();
+
+	for (uint v = 0; v < numOfNodes; v++)
+		mst->vAdjacency[v].reserve(graph->degree(v));
+	for (uint v = 0; v < numOfNodes; v++) {
+		for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++) {
+			if (v < graph->adjVertex[e])
+				newEdge(mst, v, graph->adjVertex[e], graph->cost(e));
+		}
+	}
+	mst->tree.resize(numOfNodes + mst->vEdges.size());
+
+	// Tree edges are marked first, so the walk below can follow them
+	mst->totalCost = 0;
+	for (size_t i = 0; i < result.vEdges.size(); i++) {
+		const uint e = findEdge(mst, result.vEdges[i].vertexStart, result.vEdges[i].vertexEnd);
+		mst->vEdges[e].bTree = true;
+		mst->totalCost += mst->vEdges[e].cost;
+		mst->tree.setKey(edgeNode(mst, e), treeKey(mst, e));
+	}
+	mst->numOfComponents = numOfNodes - result.vEdges.size();
+
+	// Breadth first from every vertex not reached yet, in vQueue[0], then
+	// subtree sizes bottom up to pick the heavy child of every vertex
+	vector<uint>& vOrder = mst->vQueue[0];
+	vector<uint> vParentEdge(numOfNodes, NO_EDGE), vSize(numOfNodes, 1), vHeavy(numOfNodes, NO_EDGE);
+	vOrder.clear();
+	mst->stamp = 1;
+	for (uint root = 0; root < numOfNodes; root++) {
+		if (mst->vStamps[root] == mst->stamp)
+			continue;
+		mst->vStamps[root] = mst->stamp;
+		vOrder.push_back(root);
+		for (size_t i = vOrder.size() - 1; i < vOrder.size(); i++) {
+			const uint w = vOrder[i];
+			for (size_t j = 0; j < mst->vAdjacency[w].size(); j++) {
+				const uint e = mst->vAdjacency[w][j];
+				const sDynamicEdge& edge = mst->vEdges[e];
+				const uint other = (edge.u == w) ? edge.v : edge.u;
+				if (edge.bTree && mst->vStamps[other] != mst->stamp) {
+					mst->vStamps[other] = mst->stamp;
+					vParentEdge[other] = e;
+					vOrder.push_back(other);
+				}
+			}
+		}
+	}
+	for (size_t i = vOrder.size(); i-- > 0; ) {
+		const uint w = vOrder[i];
+		if (vParentEdge[w] == NO_EDGE)
+			continue;
+		const sDynamicEdge& edge = mst->vEdges[vParentEdge[w]];
+		const uint p = (edge.u == w) ? edge.v : edge.u;
+		vSize[p] += vSize[w];
+		if (vHeavy[p] == NO_EDGE || vSize[w] > vSize[vHeavy[p]])
+			vHeavy[p] = w;
+	}
+
+	// Every heavy path becomes one splay tree, in the link-cut tree a path
+	// runs vertex, edge, vertex, ... and starts with the edge to its parent
+	vector<uint>& vPath = mst->vQueue[1];
+	for (size_t i = 0; i < vOrder.size(); i++) {
+		const uint top = vOrder[i];
+		uint pathParent = 0;
+		vPath.clear();
+		if (vParentEdge[top] != NO_EDGE) {
+			const sDynamicEdge& edge = mst->vEdges[vParentEdge[top]];
+			const uint p = (edge.u == top) ? edge.v : edge.u;
+			if (vHeavy[p] == top)
+				continue;
+			pathParent = vertexNode(p);
+			vPath.push_back(edgeNode(mst, vParentEdge[top]));
+		}
+		vPath.push_back(vertexNode(top));
+		for (uint w = top; vHeavy[w] != NO_EDGE; w = vHeavy[w]) {
+			vPath.push_back(edgeNode(mst, vParentEdge[vHeavy[w]]));
+			vPath.push_back(vertexNode(vHeavy[w]));
+		}
+		mst->tree.buildPath(&vPath[0], vPath.size(), pathParent);
+	}
+}
+
+/*
+ * Applies one batch of changes and reports the tree edges that changed.
+ * Every change costs O(log n) amortised, plus the edges of the smaller
+ * half when a tree edge is deleted or gets dearer.
+ */
+bool applyDelta(sDynamicMst* mst, const vector<sDeltaOp>& vOps, sDeltaResult* result) {
+	struct timeval start, end;
+	long seconds, useconds;
+	bool bFailed = false;
+
+	result->vAdded.clear();
+	result->vRemoved.clear();
+	result->vChanged.clear();
+	result->inserts = result->deletes = result->changes = 0;
+	result->strError.clear();
+	mst->batch++;
+	mst->vTouched.clear();
+
+	gettimeofday(&start, NULL);
+	for (size_t i = 0; i < vOps.size() && !bFailed; i++) {
+		const sDeltaOp& delta = vOps[i];
+		const uint e = findEdge(mst, delta.u, delta.v);
+		const bool bExists = e != NO_EDGE;
+
+		if (delta.op == DELTA_INSERT) {
+			if (bExists) {
+				result->strError = edgeName(delta) + " already exists, change its cost with =";
+			} else {
+				const uint added = newEdge(mst, delta.u, delta.v, delta.cost);
+				touchEdge(mst, added);
+				offerEdge(mst, added);
+				result->inserts++;
+			}
+		}
+		else if (!bExists) {
+			result->strError = edgeName(delta) + " doesn't exist";
+		}
+		else if (delta.op == DELTA_DELETE) {
+			const sDynamicEdge& edge = mst->vEdges[e];
+			const bool bTree = edge.bTree;
+			touchEdge(mst, e);
+			if (bTree)
+				removeFromTree(mst, e);
+			deleteEdge(mst, e);
+			if (bTree)
+				replaceTreeEdge(mst, edge.u, edge.v);
+			result->deletes++;
+		}
+		else {
+			sDynamicEdge& edge = mst->vEdges[e];
+			const int oldCost = edge.cost;
+			touchEdge(mst, e);
+			if (edge.bTree && delta.cost <= oldCost) {
+				// A cheaper tree edge stays in the tree
+				edge.cost = delta.cost;
+				mst->totalCost += delta.cost - oldCost;
+				mst->tree.setKey(edgeNode(mst, e), treeKey(mst, e));
+			} else if (edge.bTree) {
+				// A dearer tree edge competes with the other edges across its cut
+				removeFromTree(mst, e);
+				edge.cost = delta.cost;
+				replaceTreeEdge(mst, edge.u, edge.v);
+			} else {
+				edge.cost = delta.cost;
+				if (delta.cost < oldCost)
+					offerEdge(mst, e);
+			}
+			result->changes++;
+		}
+		bFailed = !result->strError.empty();
+	}
+
+	// Compare every touched edge with its state before the batch
+	for (size_t i = 0; i < mst->vTouched.size(); i++) {
+		const sDynamicEdge& edge = mst->vEdges[mst->vTouched[i]];
+		const bool bNowTree = edge.bAlive && edge.bTree;
+		sEdge e1;
+		e1.vertexStart = edge.u;
+		e1.vertexEnd = edge.v;
+		if (edge.bWasTree && !bNowTree) {
+			e1.cost = edge.wasCost;
+			result->vRemoved.push_back(e1);
+		} else if (!edge.bWasTree && bNowTree) {
+			e1.cost = edge.cost;
+			result->vAdded.push_back(e1);
+		} else if (bNowTree && edge.cost != edge.wasCost) {
+			e1.cost = edge.cost;
+			result->vChanged.push_back(e1);
+		}
+	}
+	// Ids of edges deleted in this batch are free from the next one on
+	mst->vFreeIds.insert(mst->vFreeIds.end(), mst->vDeadIds.begin(), mst->vDeadIds.end());
+	mst->vDeadIds.clear();
+
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = mst->totalCost;
+	result->numOfComponents = mst->numOfComponents;
+
+	return bFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
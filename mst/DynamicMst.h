@@ -0,0 +1,109 @@
+/*
+ * DynamicMst.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef DYNAMICMST_H_
+#define DYNAMICMST_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+#include "LinkCutTree.h"
+
+/*
+ * Delta file, one change per line, lines starting with # are skipped:
+ *
+ *   + u v cost   insert the edge u-v
+ *   - u v        delete the edge u-v
+ *   = u v cost   change the cost of the edge u-v
+ *
+ * Vertices are the ones of the loaded graph, a delta can't add vertices.
+ */
+enum eDeltaOp { DELTA_INSERT, DELTA_DELETE, DELTA_CHANGE };
+
+struct sDeltaOp {
+	eDeltaOp op;
+	uint u;
+	uint v;
+	int cost;
+};
+
+// Edge of the dynamic graph. Every edge sits in the adjacency of both of
+// its end points, posU and posV are its slots there
+struct sDynamicEdge {
+	uint u;
+	uint v;
+	int cost;
+	uint posU;
+	uint posV;
+	bool bTree;
+	bool bAlive;
+	// Last batch that touched the edge and its state before that batch
+	uint batch;
+	bool bWasTree;
+	int wasCost;
+};
+
+// What a batch did to the tree
+struct sDeltaResult {
+	// Edges that joined the tree, left it or stayed with a new cost
+	vector<sEdge> vAdded;
+	vector<sEdge> vRemoved;
+	vector<sEdge> vChanged;
+	int64_t totalCost;
+	// Trees of the spanning forest, 1 while the graph stays connected
+	uint numOfComponents;
+	uint64_t inserts;
+	uint64_t deletes;
+	uint64_t changes;
+	// Time spent applying the batch in microseconds
+	long mtime;
+	string strError;
+};
+
+/*
+ * Minimum spanning forest kept up to date under edge inserts, deletes and
+ * cost changes. The tree is held in a link-cut tree with one node per
+ * vertex and one per tree edge, keyed by (cost, edge id), so
+ *   - an inserted or cheaper edge replaces the heaviest edge on the tree
+ *     path between its end points if it is lighter (cycle property),
+ *   - a deleted or dearer tree edge is cut and the lightest edge across
+ *     the cut takes its place (cut property).
+ * The replacement is searched from both sides of the cut at once and the
+ * search stops when the smaller side is exhausted, so it costs the edges
+ * of the smaller side only. Everything else is O(log n) per change.
+ */
+struct sDynamicMst {
+	uint numOfNodes;
+	vector<sDynamicEdge> vEdges;
+	// Edge ids incident to every vertex
+	vector< vector<uint> > vAdjacency;
+	// Ids of deleted edges, reused from the next batch on
+	vector<uint> vFreeIds, vDeadIds;
+	sLinkCutTree tree;
+	int64_t totalCost;
+	uint numOfComponents;
+
+	// Scratch state of the current batch and of the replacement search
+	uint batch;
+	vector<uint> vTouched;
+	vector<uint> vStamps;
+	uint stamp;
+	vector<uint> vQueue[2];
+	vector<uint> vCandidates[2];
+
+	sDynamicMst():
+		numOfNodes(0),totalCost(0),numOfComponents(0),batch(0),stamp(0) {}
+};
+
+bool readDeltaFile(const string& fileName, uint numOfNodes, vector<sDeltaOp>& vOps);
+void buildDynamicMst(const sGraph* graph, const sMstResult& result, sDynamicMst* mst);
+bool applyDelta(sDynamicMst* mst, const vector<sDeltaOp>& vOps, sDeltaResult* result);
+
+#endif /* DYNAMICMST_H_ */
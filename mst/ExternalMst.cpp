@@ -0,0 +1,632 @@
+/*
+ * ExternalMst.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <queue>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ExternalMst.h"
+#include "CompressedGraph.h"
+#include "DisjointSet.h"
+#include "GraphFile.h"
+#include "GraphLoader.h"
+#include "Kruskal.h"
+
+// Edge as it is buffered and stored in a run file, 12 bytes without the
+// padding and the visited flag of sEdge
+struct sRunEdge {
+	uint32_t vertexStart;
+	uint32_t vertexEnd;
+	int32_t cost;
+};
+
+// Cost sorted run of edges in a temporary file, unlinked as it is created
+struct sRun {
+	int fd;
+	uint64_t numOfEdges;
+};
+
+// Run being written, in blocks of EXTERNAL_BLOCK_SIZE
+struct sRunWriter {
+	sRun run;
+	vector<sRunEdge> vBlock;
+};
+
+// Buffered reader of one run during a merge
+struct sRunReader {
+	const sRun* run;
+	// Edges of the run read into the buffer so far
+	uint64_t position;
+	vector<sRunEdge> vBuffer;
+	size_t next;
+	size_t size;
+};
+
+// The edge file, read a block at a time
+struct sLineReader {
+	int fd;
+	vector<char> vBlock;
+	// Bytes in the block and the bytes of it already parsed
+	size_t size;
+	size_t used;
+	bool bEof;
+
+	explicit sLineReader(int f):
+		fd(f),vBlock(EXTERNAL_BLOCK_SIZE),size(0),used(0),bEof(false) {}
+};
+
+// State shared by the phases of the external scheme
+struct sExternalState {
+	sExternalResult* result;
+	sEdgeSink* sink;
+	string strTempDir;
+	uint numOfNodes;
+	// Union-find of the vertices, reset for every filtered run and the final merge
+	sDisjointSet sets;
+	vector<sRun> vRuns;
+	// Tree edges not yet passed to the sink
+	vector<sEdge> vTree;
+};
+
+static void closeRuns(vector<sRun>& vRuns, size_t first, size_t last) {
+	for (size_t i = first; i < last; i++)
+		close(vRuns[i].fd);
+}
+
+static bool failRun(sExternalState& state, const char* action) {
+	state.result->strError = string("Unable to ") + action + " a run file in \"" + state.strTempDir + "\": "
+		+ strerror(errno);
+	return EXIT_FAILURE;
+}
+
+static bool openRun(sExternalState& state, sRunWriter& writer) {
+	string strName = state.strTempDir + "/mstrun.XXXXXX";
+	writer.run.fd = mkstemp(&strName[0]);
+	writer.run.numOfEdges = 0;
+	if (writer.run.fd < 0)
+		return failRun(state, "create");
+	// The file lives on until its descriptor is closed
+	unlink(strName.c_str());
+	writer.vBlock.reserve(EXTERNAL_BLOCK_SIZE / sizeof(sRunEdge));
+	writer.vBlock.clear();
+	return EXIT_SUCCESS;
+}
+
+static bool flushRun(sExternalState& state, sRunWriter& writer) {
+	const char* p = (const char*)writer.vBlock.data();
+	size_t size = writer.vBlock.size() * sizeof(sRunEdge);
+	state.result->runBytesWritten += size;
+	while (size > 0) {
+		const ssize_t n = write(writer.run.fd, p, size);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return failRun(state, "write");
+		p += n;
+		size -= n;
+	}
+	writer.run.numOfEdges += writer.vBlock.size();
+	writer.vBlock.clear();
+	return EXIT_SUCCESS;
+}
+
+static inline bool appendRun(sExternalState& state, sRunWriter& writer, const sRunEdge& e) {
+	writer.vBlock.push_back(e);
+	if (writer.vBlock.size() == writer.vBlock.capacity())
+		return flushRun(state, writer);
+	return EXIT_SUCCESS;
+}
+
+// Flushes the rest of the run and hands it over to vRuns
+static bool closeRun(sExternalState& state, sRunWriter& writer, vector<sRun>& vRuns) {
+	if (flushRun(state, writer)) {
+		close(writer.run.fd);
+		return EXIT_FAILURE;
+	}
+	vRuns.push_back(writer.run);
+	return EXIT_SUCCESS;
+}
+
+static bool fillReader(sExternalState& state, sRunReader& reader) {
+	const uint64_t count = min<uint64_t>(reader.vBuffer.size(), reader.run->numOfEdges - reader.position);
+	char* p = (char*)reader.vBuffer.data();
+	size_t size = count * sizeof(sRunEdge);
+	off_t offset = reader.position * sizeof(sRunEdge);
+	state.result->runBytesRead += size;
+	while (size > 0) {
+		const ssize_t n = pread(reader.run->fd, p, size, offset);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return failRun(state, "read");
+		p += n;
+		size -= n;
+		offset += n;
+	}
+	reader.position += count;
+	reader.next = 0;
+	reader.size = count;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Merges the runs into one cost ordered stream, giving every run an equal
+ * share of bufferBytes to read ahead, and calls accept(edge) on every edge
+ * in turn until it returns false. Ties go to the earlier run.
+ */
+template <class Body>
+static bool mergeRuns(sExternalState& state, const sRun* vRuns, size_t count, uint64_t bufferBytes,
+		Body accept) {
+	const uint64_t blockEdges = max<uint64_t>(1, bufferBytes / count / sizeof(sRunEdge));
+	vector<sRunReader> readers(count);
+	priority_queue< pair<int, uint>, vector< pair<int, uint> >, greater< pair<int, uint> > > heap;
+	for (uint i = 0; i < count; i++) {
+		readers[i].run = &vRuns[i];
+		readers[i].position = 0;
+		readers[i].vBuffer.resize(min(blockEdges, vRuns[i].numOfEdges));
+		if (fillReader(state, readers[i]))
+			return EXIT_FAILURE;
+		if (readers[i].size > 0)
+			heap.push(make_pair(readers[i].vBuffer[0].cost, i));
+	}
+	while (!heap.empty()) {
+		const uint i = heap.top().second;
+		sRunReader& reader = readers[i];
+		heap.pop();
+		if (!accept(reader.vBuffer[reader.next++]))
+			break;
+		if (reader.next == reader.size) {
+			if (reader.position == reader.run->numOfEdges)
+				continue;
+			if (fillReader(state, reader))
+				return EXIT_FAILURE;
+		}
+		heap.push(make_pair(reader.vBuffer[reader.next].cost, i));
+	}
+	return EXIT_SUCCESS;
+}
+
+static inline void emitTreeEdge(sExternalState& state, uint vertexStart, uint vertexEnd, int cost) {
+	sEdge e;
+	e.vertexStart = vertexStart;
+	e.vertexEnd = vertexEnd;
+	e.cost = cost;
+	state.vTree.push_back(e);
+	state.result->numOfEdges++;
+	state.result->totalCost += cost;
+	if (state.vTree.size() == state.vTree.capacity()) {
+		state.sink->write(state.vTree.data(), state.vTree.size());
+		state.vTree.clear();
+	}
+}
+
+/*
+ * Sorts the buffered edges by cost and writes them as a new run. A run of
+ * at least numOfNodes edges is cut down to its own spanning forest first:
+ * an edge closing a cycle of cheaper edges of the run can't be in the tree,
+ * and resetting the union-find costs no more than the run itself.
+ */
+static bool writeRun(sExternalState& state, vector<sRunEdge>& vEdges) {
+	sRunWriter writer;
+	sortEdgeRange(vEdges.begin(), vEdges.end());
+	const bool bFilter = vEdges.size() >= state.numOfNodes;
+	if (bFilter)
+		state.sets.reset(state.numOfNodes);
+	if (openRun(state, writer))
+		return EXIT_FAILURE;
+	for (size_t i = 0; i < vEdges.size(); i++) {
+		if (bFilter && !state.sets.unite(vEdges[i].vertexStart, vEdges[i].vertexEnd))
+			continue;
+		if (appendRun(state, writer, vEdges[i])) {
+			close(writer.run.fd);
+			return EXIT_FAILURE;
+		}
+	}
+	vEdges.clear();
+	state.result->numOfRuns++;
+	return closeRun(state, writer, state.vRuns);
+}
+
+/*
+ * Moves past the lines parsed so far and reads on until the block is full.
+ * [*first, *last) are the complete lines in the block afterwards, empty
+ * once the whole file is parsed.
+ */
+static bool nextLines(sLineReader& reader, const string& fileName, const char** first, const char** last,
+		sExternalResult* result) {
+	memmove(&reader.vBlock[0], &reader.vBlock[reader.used], reader.size - reader.used);
+	reader.size -= reader.used;
+	reader.used = 0;
+	while (!reader.bEof && reader.size < reader.vBlock.size()) {
+		const ssize_t n = read(reader.fd, &reader.vBlock[reader.size], reader.vBlock.size() - reader.size);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0) {
+			result->strError = "Unable to read file \"" + fileName + "\"";
+			return EXIT_FAILURE;
+		}
+		reader.bEof = (n == 0);
+		reader.size += n;
+		result->inputBytes += n;
+	}
+	const char* data = &reader.vBlock[0];
+	const char* end = data + reader.size;
+	if (!reader.bEof) {
+		end = (const char*)memrchr(data, '\n', reader.size);
+		if (!end) {
+			result->strError = "File \"" + fileName + "\": line longer than "
+				+ to_string(EXTERNAL_BLOCK_SIZE) + " bytes";
+			return EXIT_FAILURE;
+		}
+		end++;
+	}
+	*first = data;
+	*last = end;
+	reader.used = end - data;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Sizes the run buffer from what the memory budget leaves: the union-find,
+ * the input and run blocks and two edges per slot of the run buffer, the
+ * second one for the sort. The blocks and the smallest run buffer are the
+ * same for every graph and make up most of the minimum budget.
+ */
+static bool sizeRunBuffer(sExternalState& state, const sExternalOptions& options, uint64_t numOfHeaderEdges,
+		vector<sRunEdge>& vEdges) {
+	sExternalResult* result = state.result;
+	const uint64_t setBytes = (uint64_t)state.numOfNodes * (sizeof(uint) + sizeof(uint8_t));
+	const uint64_t bufferBytes = 2 * EXTERNAL_BLOCK_SIZE + EXTERNAL_MIN_RUN_EDGES * 2 * sizeof(sRunEdge);
+	const uint64_t minBytes = setBytes + bufferBytes;
+	if (options.memoryBudget < minBytes) {
+		result->strError = "Memory budget of " + to_string(options.memoryBudget >> 20) + " MB is too small, "
+			"at least " + to_string((minBytes + (1 << 20) - 1) >> 20) + " MB are needed: "
+			+ to_string(bufferBytes >> 10) + " KB of input, run and sort buffers for any graph and "
+			+ to_string((setBytes + 1023) >> 10) + " KB for the union-find of " + to_string(state.numOfNodes)
+			+ " vertices";
+		return EXIT_FAILURE;
+	}
+	result->numOfNodes = state.numOfNodes;
+	result->runEdges = (options.memoryBudget - setBytes - 2 * EXTERNAL_BLOCK_SIZE) / (2 * sizeof(sRunEdge));
+	vEdges.reserve(min(result->runEdges, max<uint64_t>(numOfHeaderEdges, 1)));
+	return EXIT_SUCCESS;
+}
+
+// Drops the pages of [first, last) of a read-only mapping once they are decoded
+static void releasePages(const void* first, const void* last) {
+	const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+	const uintptr_t begin = (uintptr_t)first & ~(pageSize - 1);
+	const uintptr_t end = (uintptr_t)last & ~(pageSize - 1);
+	if (end > begin)
+		madvise((void*)begin, end - begin, MADV_DONTNEED);
+}
+
+/*
+ * Phase 1 for a compressed graph file (see CompressedGraph.h). The rows are
+ * decoded straight from the mapping, every edge comes out once, and the
+ * pages decoded so far are dropped every EXTERNAL_BLOCK_SIZE bytes of gaps
+ * so the mapping doesn't grow past the budget.
+ */
+static bool formCompressedRuns(sExternalState& state, const string& fileName, const sExternalOptions& options,
+		vector<sRunEdge>& vEdges) {
+	sExternalResult* result = state.result;
+	sCompressedGraph compressed;
+	uint w;
+	int cost;
+	sRunEdge e1;
+
+	if (mapCompressedGraph(fileName, &compressed, cout))
+		return EXIT_FAILURE;
+	const sCompressedGraphHeader* header = compressed.header;
+	state.numOfNodes = header->numOfNodes;
+	result->inputBytes = header->fileSize;
+	result->numOfInputEdges = header->numOfEdges;
+	if (sizeRunBuffer(state, options, header->numOfEdges, vEdges))
+		return EXIT_FAILURE;
+
+	sRowDecoder decoder(&compressed);
+	const uint8_t* released = compressed.gaps;
+	const uint64_t* releasedCosts = compressed.costs;
+	uint64_t numOfEdges = 0;
+	for (uint v = 0; v < state.numOfNodes; v++) {
+		const uint length = decoder.beginRow(v);
+		numOfEdges += length;
+		if (numOfEdges > header->numOfEdges) {
+			result->strError = "Compressed graph file \"" + fileName + "\" has corrupt rows";
+			return EXIT_FAILURE;
+		}
+		for (uint i = 0; i < length; i++) {
+			decoder.next(&w, &cost);
+			if (w >= state.numOfNodes || w <= v) {
+				result->strError = "Compressed graph file \"" + fileName + "\" has corrupt rows";
+				return EXIT_FAILURE;
+			}
+			e1.vertexStart = v;
+			e1.vertexEnd = w;
+			e1.cost = cost;
+			vEdges.push_back(e1);
+			if (vEdges.size() == result->runEdges && writeRun(state, vEdges))
+				return EXIT_FAILURE;
+		}
+		if (decoder.gap - released >= EXTERNAL_BLOCK_SIZE) {
+			releasePages(released, decoder.gap);
+			releasePages(releasedCosts, decoder.costs + decoder.costBit / 64);
+			released = decoder.gap;
+			releasedCosts = decoder.costs + decoder.costBit / 64;
+		}
+	}
+	if (numOfEdges != header->numOfEdges) {
+		result->strError = "Compressed graph file \"" + fileName + "\" has corrupt rows";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Phase 1 for a binary graph file (see GraphFile.h). Every edge is taken
+ * from the row of its lower end point, and the pages of the rows streamed
+ * so far are dropped every EXTERNAL_BLOCK_SIZE bytes of neighbours.
+ */
+static bool formGraphFileRuns(sExternalState& state, const string& fileName, const sExternalOptions& options,
+		vector<sRunEdge>& vEdges) {
+	sExternalResult* result = state.result;
+	sGraph graph;
+	sRunEdge e1;
+
+	if (mapGraphFile(fileName, &graph, cout))
+		return EXIT_FAILURE;
+	state.numOfNodes = graph.numOfNodes;
+	result->inputBytes = graph.mappedSize;
+	result->numOfInputEdges = graph.numOfEdges;
+	if (sizeRunBuffer(state, options, graph.numOfEdges, vEdges))
+		return EXIT_FAILURE;
+
+	const char* costs = graph.costType == COST_UINT16 ? (const char*)graph.adjCost16 : (const char*)graph.adjCost;
+	const size_t costBytes = graph.costType == COST_UINT16 ? sizeof(uint16_t) : sizeof(int);
+	uint released = 0;
+	for (uint v = 0; v < state.numOfNodes; v++) {
+		for (uint64_t e = graph.offsets[v]; e < graph.offsets[v+1]; e++) {
+			if (graph.adjVertex[e] <= v)
+				continue;
+			e1.vertexStart = v;
+			e1.vertexEnd = graph.adjVertex[e];
+			e1.cost = graph.cost(e);
+			vEdges.push_back(e1);
+			if (vEdges.size() == result->runEdges && writeRun(state, vEdges))
+				return EXIT_FAILURE;
+		}
+		const uint64_t first = graph.offsets[released], last = graph.offsets[v+1];
+		if ((last - first) * sizeof(uint) >= EXTERNAL_BLOCK_SIZE) {
+			releasePages(graph.offsets + released, graph.offsets + v + 1);
+			releasePages(graph.adjVertex + first, graph.adjVertex + last);
+			releasePages(costs + first * costBytes, costs + last * costBytes);
+			released = v + 1;
+		}
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Phase 1. Streams the "n m" header and the "v1 v2 cost" lines, fills the
+ * run buffer and writes it out as a sorted run whenever it is full. The
+ * last buffer stays in memory, a file that fits in it needs no runs at all.
+ */
+static bool formRuns(sExternalState& state, int fd, const string& fileName, const sExternalOptions& options,
+		vector<sRunEdge>& vEdges) {
+	sExternalResult* result = state.result;
+	sLineReader reader(fd);
+	bool bHeader = true;
+	uint64_t line = 0, numOfHeaderEdges = 0;
+	uint v1, v2;
+	int cost;
+	sRunEdge e1;
+
+	for (;;) {
+		const char* p;
+		const char* end;
+		if (nextLines(reader, fileName, &p, &end, result))
+			return EXIT_FAILURE;
+		if (p == end)
+			break;
+		while (p < end) {
+			p = skipBlanks(p, end);
+			line++;
+			if (p < end && *p == '\n') {
+				// Empty line
+				p++;
+				continue;
+			}
+			if (p == end)
+				break;
+
+			if (bHeader) {
+				// Number of nodes and number of edges, the rest of the line is ignored
+				const char* q = parseNumber(p, end, state.numOfNodes);
+				if (q) q = parseNumber(q, end, numOfHeaderEdges);
+				if (!q || state.numOfNodes == 0xFFFFFFFFu) {
+					result->strError = "File \"" + fileName + "\": expected \"n m\" with n < 2^32-1 on line "
+						+ to_string(line);
+					return EXIT_FAILURE;
+				}
+				q = (const char*)memchr(q, '\n', end - q);
+				p = q ? q + 1 : end;
+				bHeader = false;
+				if (sizeRunBuffer(state, options, numOfHeaderEdges, vEdges))
+					return EXIT_FAILURE;
+				continue;
+			}
+
+			const char* q = parseNumber(p, end, v1);
+			if (q) q = parseNumber(q, end, v2);
+			if (q) q = parseNumber(q, end, cost);
+			if (q) q = skipBlanks(q, end);
+			if (!q || (q < end && *q != '\n')) {
+				result->strError = "File \"" + fileName + "\": expected \"v1 v2 cost\" on line " + to_string(line);
+				return EXIT_FAILURE;
+			}
+			if (v1 >= state.numOfNodes || v2 >= state.numOfNodes) {
+				result->strError = "File \"" + fileName + "\": vertex id out of range on line " + to_string(line);
+				return EXIT_FAILURE;
+			}
+			p = (q < end) ? q + 1 : q;
+			result->numOfInputEdges++;
+
+			if (v1 == v2) {
+				result->numOfSelfLoops++;
+				continue;
+			}
+			e1.vertexStart = v1;
+			e1.vertexEnd = v2;
+			e1.cost = cost;
+			vEdges.push_back(e1);
+			if (vEdges.size() == result->runEdges && writeRun(state, vEdges))
+				return EXIT_FAILURE;
+		}
+	}
+	if (bHeader) {
+		result->strError = "File \"" + fileName + "\" is empty";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Phase 2. Merges the runs fanIn at a time until at most fanIn are left,
+ * filtering every merged run of at least numOfNodes edges like writeRun
+ * does, then runs Kruskal over the final merge and passes the tree edges
+ * to the sink as they are accepted. Reading stops with the last tree edge.
+ */
+static bool mergeAllRuns(sExternalState& state, const sExternalOptions& options) {
+	sExternalResult* result = state.result;
+	const uint64_t setBytes = (uint64_t)state.numOfNodes * (sizeof(uint) + sizeof(uint8_t));
+	// Left for the read buffers once the union-find and the output block are in
+	const uint64_t mergeBytes = options.memoryBudget - setBytes - EXTERNAL_BLOCK_SIZE;
+	const size_t fanIn = max<uint64_t>(2, mergeBytes / EXTERNAL_MERGE_BLOCK_SIZE);
+	bool bFailed = false;
+
+	while (state.vRuns.size() > fanIn) {
+		vector<sRun> vNext;
+		size_t first = 0;
+		result->numOfMergePasses++;
+		for (; first < state.vRuns.size() && !bFailed; first += fanIn) {
+			const size_t count = min(fanIn, state.vRuns.size() - first);
+			if (count == 1) {
+				// Nothing to merge it with, carried over as it is
+				vNext.push_back(state.vRuns[first]);
+				continue;
+			}
+			uint64_t numOfEdges = 0;
+			for (size_t i = first; i < first + count; i++)
+				numOfEdges += state.vRuns[i].numOfEdges;
+			const bool bFilter = numOfEdges >= state.numOfNodes;
+			if (bFilter)
+				state.sets.reset(state.numOfNodes);
+			sRunWriter writer;
+			bFailed = openRun(state, writer);
+			if (!bFailed && mergeRuns(state, &state.vRuns[first], count, mergeBytes, [&](const sRunEdge& e) {
+					if (bFilter && !state.sets.unite(e.vertexStart, e.vertexEnd))
+						return true;
+					bFailed = appendRun(state, writer, e);
+					return !bFailed;
+				}))
+				bFailed = true;
+			if (!bFailed)
+				bFailed = closeRun(state, writer, vNext);
+			else if (writer.run.fd >= 0)
+				close(writer.run.fd);
+			// The merged runs free their disk space right away
+			closeRuns(state.vRuns, first, first + count);
+		}
+		// Runs the failed pass didn't get to are still open
+		vNext.insert(vNext.end(), state.vRuns.begin() + min(first, state.vRuns.size()), state.vRuns.end());
+		state.vRuns.swap(vNext);
+		if (bFailed)
+			return EXIT_FAILURE;
+	}
+
+	const uint64_t numOfTreeEdges = state.numOfNodes > 0 ? state.numOfNodes - 1 : 0;
+	state.sets.reset(state.numOfNodes);
+	return mergeRuns(state, state.vRuns.data(), state.vRuns.size(), mergeBytes, [&](const sRunEdge& e) {
+		if (state.sets.unite(e.vertexStart, e.vertexEnd))
+			emitTreeEdge(state, e.vertexStart, e.vertexEnd, e.cost);
+		return result->numOfEdges < numOfTreeEdges;
+	});
+}
+
+/* Algorithm :
+		Semi-external Kruskal, only the per-vertex union-find has to fit in
+		memory, the edges never do.
+		1.	Stream the edges of the text file, or the rows of a binary or
+			compressed graph file, into a buffer sized from the memory budget.
+			Every time it fills up, sort it by cost and write it out as a run,
+			cut down to its spanning forest when it has at least n edges.
+		2.	If the whole file fit in the buffer, run Kruskal on it in memory.
+		3.	Otherwise merge the runs, as many at a time as the budget has read
+			buffers for, until few enough are left for a single merge.
+		4.	Run Kruskal over the final merge of the runs, passing every tree
+			edge to the sink as it is accepted, until n-1 edges are found or
+			the runs are exhausted, which leaves a spanning forest.
+*/
+bool generateExternalMst(const string& fileName, const sExternalOptions& options, sEdgeSink* sink,
+		sExternalResult* result) {
+	struct timeval start, runEnd, end;
+	sExternalState state;
+	vector<sRunEdge> vEdges;
+	bool bFailed;
+
+	gettimeofday(&start, NULL);
+	*result = sExternalResult();
+	state.result = result;
+	state.sink = sink;
+	state.numOfNodes = 0;
+	state.strTempDir = options.strTempDir;
+	if (state.strTempDir.empty())
+		state.strTempDir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+	state.vTree.reserve(EXTERNAL_BLOCK_SIZE / sizeof(sEdge));
+
+	if (isCompressedGraphFile(fileName)) {
+		bFailed = formCompressedRuns(state, fileName, options, vEdges);
+	} else if (isGraphFile(fileName)) {
+		bFailed = formGraphFileRuns(state, fileName, options, vEdges);
+	} else {
+		int fd = open(fileName.c_str(), O_RDONLY);
+		if (fd < 0) {
+			result->strError = "Unable to open file \"" + fileName + "\"";
+			return EXIT_FAILURE;
+		}
+		posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+		bFailed = formRuns(state, fd, fileName, options, vEdges);
+		close(fd);
+	}
+	gettimeofday(&runEnd, NULL);
+	result->runTime = (runEnd.tv_sec - start.tv_sec) * 1000000 + (runEnd.tv_usec - start.tv_usec);
+
+	if (!bFailed && state.vRuns.empty()) {
+		// Everything fit in one buffer
+		sortEdgeRange(vEdges.begin(), vEdges.end());
+		state.sets.reset(state.numOfNodes);
+		for (size_t i = 0; i < vEdges.size() && result->numOfEdges + 1 < state.numOfNodes; i++)
+			if (state.sets.unite(vEdges[i].vertexStart, vEdges[i].vertexEnd))
+				emitTreeEdge(state, vEdges[i].vertexStart, vEdges[i].vertexEnd, vEdges[i].cost);
+	}
+	else if (!bFailed) {
+		if (!vEdges.empty())
+			bFailed = writeRun(state, vEdges);
+		vector<sRunEdge>().swap(vEdges);
+		if (!bFailed)
+			bFailed = mergeAllRuns(state, options);
+	}
+	closeRuns(state.vRuns, 0, state.vRuns.size());
+	if (!state.vTree.empty())
+		sink->write(state.vTree.data(), state.vTree.size());
+
+	gettimeofday(&end, NULL);
+	result->mtime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+	return bFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
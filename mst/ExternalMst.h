@@ -0,0 +1,73 @@
+/*
+ * ExternalMst.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef EXTERNALMST_H_
+#define EXTERNALMST_H_
+
+#include <string>
+#include <stdint.h>
+#include "Global.h"
+
+// The edge file is read and the runs are written in blocks of this size
+#define EXTERNAL_BLOCK_SIZE (1 << 20)
+// Smallest read buffer of a run during a merge, sets the merge fan-in
+#define EXTERNAL_MERGE_BLOCK_SIZE (64 << 10)
+// A run buffer smaller than this many edges makes too many runs to merge
+#define EXTERNAL_MIN_RUN_EDGES (1 << 16)
+// Memory budget in megabytes when --memory isn't given
+#define EXTERNAL_DEFAULT_MEMORY 1024
+
+struct sExternalOptions {
+	// Bytes the union-find, the run buffer and the merge buffers may take
+	uint64_t memoryBudget;
+	// Directory of the run files, $TMPDIR or /tmp when empty
+	string strTempDir;
+	// A spanning forest of a disconnected graph is the answer, not a failure
+	bool bForest;
+
+	sExternalOptions():
+		memoryBudget((uint64_t)EXTERNAL_DEFAULT_MEMORY << 20),bForest(false) {}
+};
+
+// Receives the tree edges in blocks as the final merge accepts them
+struct sEdgeSink {
+	virtual ~sEdgeSink() {}
+	virtual void write(const sEdge* vEdges, size_t count) = 0;
+};
+
+// What the external scheme found and how much it read and wrote
+struct sExternalResult {
+	uint numOfNodes;
+	// "v1 v2 cost" lines of the file and the self loops among them
+	uint64_t numOfInputEdges;
+	uint64_t numOfSelfLoops;
+	// Tree edges passed to the sink, fewer than numOfNodes-1 for a forest
+	uint64_t numOfEdges;
+	int64_t totalCost;
+	// Edges a run buffer holds, sorted runs written and merge passes over them
+	uint64_t runEdges;
+	uint numOfRuns;
+	uint numOfMergePasses;
+	// I/O volume in bytes
+	uint64_t inputBytes;
+	uint64_t runBytesWritten;
+	uint64_t runBytesRead;
+	// Time of the whole scheme and of forming the runs, in microseconds
+	long mtime;
+	long runTime;
+	string strError;
+
+	sExternalResult():
+		numOfNodes(0),numOfInputEdges(0),numOfSelfLoops(0),numOfEdges(0),totalCost(0),runEdges(0),
+		numOfRuns(0),numOfMergePasses(0),inputBytes(0),runBytesWritten(0),runBytesRead(0),mtime(0),
+		runTime(0) {}
+};
+
+bool generateExternalMst(const string& fileName, const sExternalOptions& options, sEdgeSink* sink,
+		sExternalResult* result);
+
+#endif /* EXTERNALMST_H_ */
@@ -5,9 +5,14 @@
  *  Author: Sagar
  *  Algorithm: http://www.cse.yorku.ca/~aaw/Jason/FibonacciHeapAlgorithm.html
  */
+#ifndef FIBONACCIHEAP_HPP_
+#define FIBONACCIHEAP_HPP_
+
 #include <iostream>
 #include <algorithm>
 #include <vector>
+#include "Global.h"
+#include "FibonacciHeapStats.hpp"
 using namespace std;
 
 /*
@@ -151,6 +156,9 @@ class FHeap {
 	uint count;
 	// Maximum degree of a root in the  circular d-list
 	uint maxDegree;
+#ifdef FHEAP_STATS
+	sFHeapStats stats;
+#endif
 
 protected:
 	// Insert a node into the HeapNode structure 1<->2<->3<->4
@@ -170,15 +178,34 @@ protected:
 		return newNode;
 	}
 
+	// Frees a circular list of nodes together with all their children
+	static void deleteNodes(fNode first) {
+		fNode n = first;
+		do {
+			fNode next = n->next;
+			if (n->child)
+				deleteNodes(n->child);
+			delete n;
+			n = next;
+		} while (n != first);
+	}
+
 public:
 
 	FHeap():
 		rootWithMinKey(NULL), count(0), maxDegree(0) {}
 
-	~FHeap() {}
+	~FHeap() {
+		if (rootWithMinKey)
+			deleteNodes(rootWithMinKey);
+	}
 
 	bool empty() const {return count==0;}
 
+#ifdef FHEAP_STATS
+	const sFHeapStats& statistics() const { return stats; }
+#endif
+
 	// For debug purpose
 	void printRoots() const {
 		cout << "maxDegree = " << maxDegree << "  count= " << count << "  roots= ";
@@ -201,6 +228,9 @@ public:
 	fNode insert (uint data, int key) {
 #ifdef LOG_ON
 		cout << "insert " << data << ":" << nodeKey << endl;
+#endif
+#ifdef FHEAP_STATS
+		stats.inserts++;
 #endif
 		count++;
 		return insertNode(new FHeapNode(data,key));
@@ -219,6 +249,9 @@ public:
 
 #ifdef LOG_ON
 		cout << "In removeMinimum" << endl;
+#endif
+#ifdef FHEAP_STATS
+		stats.removeMins++;
 #endif
 		count--;
 
@@ -253,6 +286,7 @@ public:
 				cout << "F-heap Error: Internal error: should have 0 keys" << endl;
 				exit(EXIT_FAILURE);
 			}
+			delete rootWithMinKey;
 			rootWithMinKey = NULL;
 			return;
 		}
@@ -264,7 +298,13 @@ public:
 		maxDegree = 0;
 		fNode currentPointer = rootWithMinKey->next;
 		uint currentDegree;
+#ifdef FHEAP_STATS
+		uint64_t rootListLength = 0;
+#endif
 		do {
+#ifdef FHEAP_STATS
+			rootListLength++;
+#endif
 			currentDegree = currentPointer->degree;
 #ifdef LOG_ON
 			cout << "  roots starting from currentPointer: ";
@@ -290,10 +330,17 @@ public:
 				currentDegree++;
 				if (currentDegree >= degreeRoots.size())
 					degreeRoots.push_back((fNode)NULL);
+#ifdef FHEAP_STATS
+				stats.links++;
+				stats.maxDegree = max(stats.maxDegree, currentDegree);
+#endif
 			}
 			// keep the current root as the first of its degree in the degrees vector
 			degreeRoots[currentDegree] = current;
 		} while (currentPointer != rootWithMinKey);
+#ifdef FHEAP_STATS
+		stats.addRootList(rootListLength);
+#endif
 
 		// Remove the current root, and calculate the new rootWithMinKey
 		delete rootWithMinKey;
@@ -329,6 +376,10 @@ public:
 
 #ifdef LOG_ON
 		cout << "Decreasing key of " << *node << " to " << newKey << endl;
+#endif
+#ifdef FHEAP_STATS
+		stats.decreaseKeys++;
+		uint cuts = 0;
 #endif
 		// Update the key and possibly the min key
 		node->nodeKey = newKey;
@@ -349,6 +400,9 @@ public:
 		while(true){
 			parent->removeChild(node);
 			insertNode(node);
+#ifdef FHEAP_STATS
+			cuts++;
+#endif
 #ifdef LOG_ON
 				cout << "Removed " << *node << " as child of " << *parent << endl;
 				cout << "Roots after remove: ";
@@ -367,9 +421,11 @@ public:
 				continue;
 			}
 		}
+#ifdef FHEAP_STATS
+		stats.addCascade(cuts);
+#endif
 	}
 
 };
 
-
-
+#endif /* FIBONACCIHEAP_HPP_ */
@@ -0,0 +1,69 @@
+/*
+ * FibonacciHeapStats.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#ifndef FIBONACCIHEAPSTATS_HPP_
+#define FIBONACCIHEAPSTATS_HPP_
+
+#include <iostream>
+#include <algorithm>
+#include <stdint.h>
+using namespace std;
+
+// Cascading cuts of 1, 2, ... this many or more cuts are counted apart
+#define FHEAP_CUT_DEPTHS 8
+
+/*
+ * Operation counters of FHeap and FIndexHeap. The heaps only keep them when
+ * FHEAP_STATS is defined (see Global.h), otherwise nothing is counted.
+ */
+struct sFHeapStats {
+	uint64_t inserts;
+	uint64_t removeMins;
+	// Trees linked under another root while consolidating
+	uint64_t links;
+	uint64_t decreaseKeys;
+	// decreaseKey calls that cut the node, by the number of cuts they made
+	uint64_t cutDepths[FHEAP_CUT_DEPTHS];
+	uint64_t consolidations;
+	// Length of the root list before each consolidation
+	uint64_t rootListSum;
+	uint64_t rootListMax;
+	uint maxDegree;
+
+	sFHeapStats() { reset(); }
+
+	void reset() {
+		inserts = removeMins = links = decreaseKeys = consolidations = 0;
+		fill(cutDepths, cutDepths + FHEAP_CUT_DEPTHS, 0);
+		rootListSum = rootListMax = 0;
+		maxDegree = 0;
+	}
+
+	void addRootList(uint64_t length) {
+		consolidations++;
+		rootListSum += length;
+		rootListMax = max(rootListMax, length);
+	}
+
+	void addCascade(uint cuts) {
+		cutDepths[min(cuts, (uint)FHEAP_CUT_DEPTHS) - 1]++;
+	}
+
+	friend ostream& operator<<(ostream& out, const sFHeapStats& s) {
+		out << "Inserts = " << s.inserts << ", RemoveMins = " << s.removeMins
+			<< ", Links = " << s.links << ", DecreaseKeys = " << s.decreaseKeys << endl;
+		out << "Cascading cuts by depth =";
+		for (uint d = 0; d < FHEAP_CUT_DEPTHS; d++)
+			out << " " << s.cutDepths[d];
+		out << " (last is " << FHEAP_CUT_DEPTHS << "+)" << endl;
+		out << "Root list before consolidation: avg = "
+			<< (s.consolidations ? (double)s.rootListSum / s.consolidations : 0)
+			<< ", max = " << s.rootListMax << ", MaxDegree = " << s.maxDegree << endl;
+		return out;
+	}
+};
+
+#endif /* FIBONACCIHEAPSTATS_HPP_ */
@@ -0,0 +1,308 @@
+/*
+ * FibonacciIndexHeap.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ *  Algorithm: http://www.cse.yorku.ca/~aaw/Jason/FibonacciHeapAlgorithm.html
+ */
+#ifndef FIBONACCIINDEXHEAP_HPP_
+#define FIBONACCIINDEXHEAP_HPP_
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+#include <stdlib.h>
+#include "Global.h"
+#include "FibonacciHeapStats.hpp"
+using namespace std;
+
+/*
+ * F-heap over a preallocated node array. Same algorithm as FHeap, but the
+ * capacity is given up front, node i always holds data i and all links are
+ * 32-bit indexes into the node array. Nothing is allocated after
+ * construction: the consolidation degree table is kept between calls.
+ */
+class FIndexHeap {
+public:
+	// Marks an empty link
+	enum { NIL = 0xFFFFFFFF };
+
+private:
+	struct sFNode {
+		int key;
+		// Number of children
+		uint32_t degree;
+		// Links for circular doubly linked list
+		uint32_t previous;
+		uint32_t next;
+		// First child and parent
+		uint32_t child;
+		uint32_t parent;
+		// Used in the decreaseKey algorithm
+		bool mark;
+	};
+
+	vector<sFNode> nodes;
+	// Roots indexed by degree during consolidation. Always all NIL between calls
+	vector<uint32_t> degreeRoots;
+	uint32_t rootWithMinKey;
+	// Total number of elements in heap
+	uint count;
+#ifdef FHEAP_STATS
+	sFHeapStats stats;
+#endif
+
+	// Splices the circular list starting at other after node
+	void listInsert(uint32_t node, uint32_t other) {
+		sFNode& n = nodes[node];
+		sFNode& o = nodes[other];
+		nodes[n.next].previous = o.previous;
+		nodes[o.previous].next = n.next;
+		n.next = other;
+		o.previous = node;
+	}
+
+	// Remove node from its list of nodes
+	void listRemove(uint32_t node) {
+		sFNode& n = nodes[node];
+		nodes[n.previous].next = n.next;
+		nodes[n.next].previous = n.previous;
+		n.next = n.previous = node;
+	}
+
+	// Add a child - increase degree
+	void addChild(uint32_t node, uint32_t other) {
+		sFNode& n = nodes[node];
+		if (n.child == NIL)
+			n.child = other;
+		else
+			listInsert(n.child, other);
+		nodes[other].parent = node;
+		nodes[other].mark = false;
+		n.degree++;
+	}
+
+	// Remove Child - decrease degree
+	void removeChild(uint32_t node, uint32_t other) {
+		sFNode& n = nodes[node];
+		sFNode& o = nodes[other];
+		if (o.parent != node) {
+			cout << "F-heap Error: Trying to remove a child from a non-parent" << endl;
+			exit(EXIT_FAILURE);
+		}
+		if (o.next == other) {
+			n.child = NIL;
+		} else {
+			if (n.child == other)
+				n.child = o.next;
+			listRemove(other);
+		}
+		o.parent = NIL;
+		o.mark = false;
+		n.degree--;
+	}
+
+	// Insert a single node into the list of roots
+	void insertRoot(uint32_t node) {
+		if (rootWithMinKey == NIL) {
+			rootWithMinKey = node;
+		} else {
+			listInsert(rootWithMinKey, node);
+			if (nodes[node].key < nodes[rootWithMinKey].key)
+				rootWithMinKey = node;
+		}
+	}
+
+	// Non copyable, the heap owns one big node array
+	FIndexHeap(const FIndexHeap&);
+	FIndexHeap& operator=(const FIndexHeap&);
+
+public:
+
+	explicit FIndexHeap(uint capacity):
+		nodes(capacity), rootWithMinKey(NIL), count(0) {
+		// Max degree of an F-heap with n nodes is log_phi(n) < 1.45*log2(n)
+		uint maxDegree = 2;
+		for (uint n = capacity; n > 1; n >>= 1)
+			maxDegree += 2;
+		degreeRoots.assign(maxDegree, NIL);
+	}
+
+	~FIndexHeap() {}
+
+	bool empty() const { return count == 0; }
+	uint size() const { return count; }
+	uint capacity() const { return nodes.size(); }
+
+#ifdef FHEAP_STATS
+	const sFHeapStats& statistics() const { return stats; }
+#endif
+
+	// Drops all elements, keeps the storage for the next run
+	void clear() {
+		rootWithMinKey = NIL;
+		count = 0;
+	}
+
+	// Data of the minimum element
+	uint32_t minimum() const {
+		if (rootWithMinKey == NIL) {
+			cout << "F-heap Error: No min element" << endl;
+			exit(EXIT_FAILURE);
+		}
+		return rootWithMinKey;
+	}
+
+	int minimumKey() const { return nodes[minimum()].key; }
+
+	int key(uint32_t node) const { return nodes[node].key; }
+
+	// Insert data with the given key. data must be less than the capacity
+	uint32_t insert(uint32_t data, int key) {
+#ifdef LOG_ON
+		cout << "insert " << data << ":" << key << endl;
+#endif
+#ifdef FHEAP_STATS
+		stats.inserts++;
+#endif
+		sFNode& n = nodes[data];
+		n.key = key;
+		n.degree = 0;
+		n.previous = n.next = data;
+		n.child = n.parent = NIL;
+		n.mark = false;
+		count++;
+		insertRoot(data);
+		return data;
+	}
+
+	/*
+	 * removeMin of F-Heap
+	 * Algorithm part: Fibonacci-Heap-Extract-Min, CONSOLIDATE
+	 */
+	void removeMinimum() {
+		if (rootWithMinKey == NIL) {
+			cout << "F-heap Error: trying to remove from an empty heap" << endl;
+			exit(EXIT_FAILURE);
+		}
+		const uint32_t minNode = rootWithMinKey;
+		count--;
+#ifdef FHEAP_STATS
+		stats.removeMins++;
+#endif
+
+		// Make all children of root new roots
+		uint32_t c = nodes[minNode].child;
+		if (c != NIL) {
+			do {
+				nodes[c].parent = NIL;
+				c = nodes[c].next;
+			} while (c != nodes[minNode].child);
+			nodes[minNode].child = NIL;
+			listInsert(minNode, c);
+		}
+
+		// Handle the case where we delete the last key
+		if (nodes[minNode].next == minNode) {
+			if (count != 0) {
+				cout << "F-heap Error: Internal error: should have 0 keys" << endl;
+				exit(EXIT_FAILURE);
+			}
+			rootWithMinKey = NIL;
+			return;
+		}
+
+		// Merge roots with the same degree - CONSOLIDATE
+		uint32_t currentPointer = nodes[minNode].next;
+#ifdef FHEAP_STATS
+		uint64_t rootListLength = 0;
+#endif
+		do {
+#ifdef FHEAP_STATS
+			rootListLength++;
+#endif
+			uint32_t currentDegree = nodes[currentPointer].degree;
+			uint32_t current = currentPointer;
+			currentPointer = nodes[currentPointer].next;
+			while (degreeRoots[currentDegree] != NIL) {
+				uint32_t other = degreeRoots[currentDegree];
+				if (nodes[current].key > nodes[other].key)
+					swap(other, current);
+				listRemove(other);
+				addChild(current, other);
+				degreeRoots[currentDegree] = NIL;
+				currentDegree++;
+				if (currentDegree >= degreeRoots.size())
+					degreeRoots.push_back(NIL);
+#ifdef FHEAP_STATS
+				stats.links++;
+				stats.maxDegree = max(stats.maxDegree, currentDegree);
+#endif
+			}
+			degreeRoots[currentDegree] = current;
+		} while (currentPointer != minNode);
+#ifdef FHEAP_STATS
+		stats.addRootList(rootListLength);
+#endif
+
+		// Rebuild the root list and find the new minimum, leaving the table empty
+		rootWithMinKey = NIL;
+		for (uint d = 0; d < degreeRoots.size(); d++) {
+			const uint32_t root = degreeRoots[d];
+			if (root != NIL) {
+				nodes[root].next = nodes[root].previous = root;
+				insertRoot(root);
+				degreeRoots[d] = NIL;
+			}
+		}
+	}
+
+	void decreaseKey(uint32_t node, int newKey) {
+		if (newKey >= nodes[node].key) {
+			cout << "Trying to decrease key to a greater key" << endl;
+			exit(EXIT_FAILURE);
+		}
+#ifdef LOG_ON
+		cout << "Decreasing key of " << node << " to " << newKey << endl;
+#endif
+#ifdef FHEAP_STATS
+		stats.decreaseKeys++;
+		uint cuts = 0;
+#endif
+		nodes[node].key = newKey;
+		uint32_t parent = nodes[node].parent;
+
+		// Root node - just make sure the minimum is correct
+		if (parent == NIL) {
+			if (newKey < nodes[rootWithMinKey].key)
+				rootWithMinKey = node;
+			return;
+		} else if (nodes[parent].key <= newKey) {
+			return;
+		}
+
+		// Cascading cut
+		while (true) {
+			removeChild(parent, node);
+			insertRoot(node);
+#ifdef FHEAP_STATS
+			cuts++;
+#endif
+			if (nodes[parent].parent == NIL) {
+				break;
+			} else if (!nodes[parent].mark) {
+				nodes[parent].mark = true;
+				break;
+			} else {
+				node = parent;
+				parent = nodes[parent].parent;
+			}
+		}
+#ifdef FHEAP_STATS
+		stats.addCascade(cuts);
+#endif
+	}
+};
+
+#endif /* FIBONACCIINDEXHEAP_HPP_ */
@@ -8,18 +8,24 @@
 #ifndef GLOBAL_H_
 #define GLOBAL_H_
 
-#define MAX_NODES 10000
 #define MAX_COST 10000
+// Heap key of a vertex no edge has reached yet. A cost may equal it, so the
+// Prim schemes keep whether a vertex was reached in a bitmap of their own
+#define UNREACHED_KEY INT_MAX
 //Uncomment to start in debug mode
 //#define LOG_ON 1
+//Uncomment to count F-heap operations, printed by the Fibonacci scheme
+//#define FHEAP_STATS 1
 
 #include <sys/time.h>
 #include <ctime>
+#include <climits>
 #include <stdio.h>
 #include <stdlib.h>
 #include <list>
 #include <vector>
 #include <iomanip>
+#include <iostream>
 
 using namespace std;
 
@@ -49,23 +55,33 @@ struct sEdge {
 		return false;
 	}
 	friend ostream& operator<<(ostream& out, const sEdge& e){
-		return(cout << "[" << e.vertexStart << ", " << e.vertexEnd << ", "<< e.cost <<"]");
+		return(out << "[" << e.vertexStart << ", " << e.vertexEnd << ", "<< e.cost <<"]");
 	}
 };
 
-// Structure to represent a vertex(node) in a graph
-struct sVertex {
-	int id;
-	bool visited;
-    list<sEdge> adj;   // adjacency list of (edge,cost)
-
-    sVertex():
-    	id(0),visited(false),adj(0) {}
+// Scratch buffers of the Prim schemes, one per concurrent solve. Sized from
+// the graph on first use and kept, so repeated runs don't allocate again
+struct sWorkspace {
+	// Current key of every vertex
+	vector<int> vKeys;
+	// Parent from where the vertex can be reached with the least cost
+	vector<uint> vParentIds;
+	// Vertices already in the tree
+	vector<bool> vVisited;
+	// Vertices an edge has reached, only their keys are costs
+	vector<bool> vReached;
+	// Vertices in the heap of the heap scheme
+	vector<bool> vInHeap;
 
-    friend ostream& operator<< (ostream& out, const sVertex& n) {
-		out << "[VertexId=" << n.id << "]";
-		return out;
-    }
+	void reserve(uint numOfNodes) {
+		if (vKeys.size() < numOfNodes) {
+			vKeys.resize(numOfNodes);
+			vParentIds.resize(numOfNodes);
+			vVisited.resize(numOfNodes);
+			vReached.resize(numOfNodes);
+			vInHeap.resize(numOfNodes);
+		}
+	}
 };
 
 #endif /* GLOBAL_H_ */
@@ -0,0 +1,99 @@
+/*
+ * Graph.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <sys/mman.h>
+#include "Graph.h"
+
+/*
+ * Builds the CSR arrays from an edge list. Degrees are counted first, turned
+ * into offsets with a prefix sum and then both directions of every edge are
+ * scattered into their slots.
+ */
+void buildGraph(sGraph* graph, const uint numOfNodes, const vector<sEdge>& vEdges) {
+	releaseGraph(graph);
+	graph->numOfNodes = numOfNodes;
+	graph->numOfEdges = vEdges.size();
+	vector<uint64_t>& offsets = graph->vOffsets;
+	offsets.assign(numOfNodes + 1, 0);
+	graph->vAdjVertex.resize(2 * vEdges.size());
+	graph->vAdjCost.resize(2 * vEdges.size());
+
+	// Count degree of every vertex
+	for (vector<sEdge>::const_iterator it = vEdges.begin(); it != vEdges.end(); it++) {
+		offsets[it->vertexStart + 1]++;
+		offsets[it->vertexEnd + 1]++;
+	}
+	for (uint i = 0; i < numOfNodes; i++)
+		offsets[i+1] += offsets[i];
+
+	// Fill both directions, pos[v] is the next free slot of vertex v
+	vector<uint64_t> pos(offsets.begin(), offsets.end() - 1);
+	for (vector<sEdge>::const_iterator it = vEdges.begin(); it != vEdges.end(); it++) {
+		uint64_t slot = pos[it->vertexStart]++;
+		graph->vAdjVertex[slot] = it->vertexEnd;
+		graph->vAdjCost[slot] = it->cost;
+
+		slot = pos[it->vertexEnd]++;
+		graph->vAdjVertex[slot] = it->vertexStart;
+		graph->vAdjCost[slot] = it->cost;
+	}
+	compactCosts(graph);
+#ifdef LOG_ON
+	cout << "CSR graph built with " << numOfNodes << " vertices and " << vEdges.size() << " edges" << endl;
+#endif
+}
+
+/*
+ * Points the CSR arrays at the vectors owned by the graph
+ */
+void attachOwnedArrays(sGraph* graph) {
+	graph->offsets = graph->vOffsets.empty() ? NULL : &graph->vOffsets[0];
+	graph->adjVertex = graph->vAdjVertex.empty() ? NULL : &graph->vAdjVertex[0];
+	graph->adjCost = graph->vAdjCost.empty() ? NULL : &graph->vAdjCost[0];
+	graph->adjCost16 = graph->vAdjCost16.empty() ? NULL : &graph->vAdjCost16[0];
+}
+
+/*
+ * Moves the owned costs into 16-bit storage if every one of them fits and
+ * attaches the arrays. Called once a graph is built in memory.
+ */
+void compactCosts(sGraph* graph) {
+	bool bNarrow = true;
+	for (size_t e = 0; e < graph->vAdjCost.size() && bNarrow; e++)
+		bNarrow = graph->vAdjCost[e] >= 0 && graph->vAdjCost[e] <= NARROW_COST_MAX;
+	graph->costType = bNarrow ? COST_UINT16 : COST_INT32;
+	if (bNarrow) {
+		graph->vAdjCost16.assign(graph->vAdjCost.begin(), graph->vAdjCost.end());
+		vector<int>().swap(graph->vAdjCost);
+	}
+	attachOwnedArrays(graph);
+}
+
+/*
+ * Drops the arrays of the graph, unmapping the graph file if it came from one
+ */
+void releaseGraph(sGraph* graph) {
+	if (graph->mappedBase) {
+		munmap(graph->mappedBase, graph->mappedSize);
+		graph->mappedBase = NULL;
+		graph->mappedSize = 0;
+	}
+	graph->vOffsets.clear();
+	graph->vAdjVertex.clear();
+	graph->vAdjCost.clear();
+	graph->vAdjCost16.clear();
+	graph->offsets = NULL;
+	graph->adjVertex = NULL;
+	graph->costType = COST_INT32;
+	graph->adjCost = NULL;
+	graph->adjCost16 = NULL;
+	graph->numOfNodes = 0;
+	graph->numOfEdges = 0;
+}
+
+sGraph::~sGraph() {
+	releaseGraph(this);
+}
@@ -0,0 +1,86 @@
+/*
+ * Graph.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef GRAPH_H_
+#define GRAPH_H_
+
+#include <iostream>
+#include <stdint.h>
+#include "Global.h"
+
+// Largest cost a graph with 16-bit costs can hold
+#define NARROW_COST_MAX 0xFFFF
+
+// Width of the edge costs of a graph
+enum eCostType {
+	COST_INT32,
+	// Every cost in [0, NARROW_COST_MAX], as they are in generated graphs
+	COST_UINT16
+};
+
+/*
+ * Undirected graph in compressed sparse row (CSR) form. The neighbours of
+ * vertex v are stored contiguously in adjVertex/adjCost between
+ * offsets[v] and offsets[v+1], so scanning a vertex is a linear sweep.
+ * Every undirected edge is stored once in each direction.
+ *
+ * The arrays are either owned by the graph (built in memory by buildGraph)
+ * or point straight into a memory mapped graph file (see GraphFile.h).
+ * The MST schemes only read the graph, so one graph can be solved by
+ * several threads at once.
+ *
+ * Costs are kept in adjCost16 instead of adjCost when all of them fit in 16
+ * bits, which cuts an adjacency entry from 8 to 6 bytes. The hot Prim loops
+ * are instantiated for both widths, everything else reads through cost().
+ */
+struct sGraph {
+	uint numOfNodes;
+	uint64_t numOfEdges;
+	// numOfNodes+1 entries, offsets[numOfNodes] == 2*numOfEdges
+	const uint64_t* offsets;
+	// Packed neighbour ids and edge costs, only the array of costType is set
+	const uint* adjVertex;
+	eCostType costType;
+	const int* adjCost;
+	const uint16_t* adjCost16;
+
+	// Backing storage of a graph built in memory
+	vector<uint64_t> vOffsets;
+	vector<uint> vAdjVertex;
+	vector<int> vAdjCost;
+	vector<uint16_t> vAdjCost16;
+	// Backing mapping of a graph read from a binary graph file
+	void* mappedBase;
+	size_t mappedSize;
+
+	sGraph():
+		numOfNodes(0),numOfEdges(0),offsets(NULL),adjVertex(NULL),costType(COST_INT32),adjCost(NULL),
+		adjCost16(NULL),mappedBase(NULL),mappedSize(0) {}
+
+	~sGraph();
+
+	inline uint64_t degree(uint v) const {
+		return offsets[v+1] - offsets[v];
+	}
+
+	// Cost of adjacency entry e, whatever the width
+	inline int cost(uint64_t e) const {
+		return costType == COST_UINT16 ? adjCost16[e] : adjCost[e];
+	}
+
+private:
+	// The arrays may point into the graph itself, so it can't be copied
+	sGraph(const sGraph&);
+	sGraph& operator=(const sGraph&);
+};
+
+void buildGraph(sGraph* graph, const uint numOfNodes, const vector<sEdge>& vEdges);
+void attachOwnedArrays(sGraph* graph);
+void compactCosts(sGraph* graph);
+void releaseGraph(sGraph* graph);
+
+#endif /* GRAPH_H_ */
@@ -0,0 +1,178 @@
+/*
+ * GraphFile.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "GraphFile.h"
+
+/*
+ * Checks the magic number only, so the text loader can be used otherwise
+ */
+bool isGraphFile(const string& fileName) {
+	char magic[8];
+	ifstream file(fileName.c_str(), ios::binary);
+	if (!file.read(magic, sizeof(magic)))
+		return false;
+	return memcmp(magic, GRAPH_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+// Writes size bytes followed by zero padding up to the next aligned position
+void writeAligned(ofstream& file, const void* data, uint64_t size) {
+	static const char zeros[GRAPH_FILE_ALIGNMENT] = {};
+	file.write((const char*)data, size);
+	const uint64_t pos = file.tellp();
+	file.write(zeros, alignPos(pos) - pos);
+}
+
+// Bytes of one cost in a graph file
+static inline uint64_t costSize(uint32_t costType) {
+	return costType == COST_UINT16 ? sizeof(uint16_t) : sizeof(int32_t);
+}
+
+/*
+ * Writes the CSR arrays of the graph in the binary graph file format, the
+ * costs in the width the graph holds them
+ */
+bool writeGraphFile(const string& fileName, const sGraph* graph) {
+	sGraphFileHeader header;
+	const uint64_t numOfSlots = 2 * graph->numOfEdges;
+	const bool bNarrow = graph->costType == COST_UINT16;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+	header.version = GRAPH_FILE_VERSION;
+	header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+	header.numOfNodes = graph->numOfNodes;
+	header.numOfEdges = graph->numOfEdges;
+	header.offsetsPos = alignPos(sizeof(header));
+	header.adjVertexPos = alignPos(header.offsetsPos + (graph->numOfNodes + 1) * sizeof(uint64_t));
+	header.adjCostPos = alignPos(header.adjVertexPos + numOfSlots * sizeof(uint32_t));
+	header.fileSize = alignPos(header.adjCostPos + numOfSlots * costSize(graph->costType));
+	header.costType = graph->costType;
+
+	ofstream file(fileName.c_str(), ios::binary | ios::trunc);
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	writeAligned(file, &header, sizeof(header));
+	writeAligned(file, graph->offsets, (graph->numOfNodes + 1) * sizeof(uint64_t));
+	writeAligned(file, graph->adjVertex, numOfSlots * sizeof(uint32_t));
+	if (bNarrow)
+		writeAligned(file, graph->adjCost16, numOfSlots * sizeof(uint16_t));
+	else
+		writeAligned(file, graph->adjCost, numOfSlots * sizeof(int32_t));
+	file.close();
+	if (file.fail()) {
+		cout << "Unable to write file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Maps a binary graph file read-only and points the CSR arrays of graph into
+ * the mapping. The pages are shared through the page cache with every other
+ * process mapping the same file, and read once up front by the check of the
+ * arrays. Errors go to messages.
+ */
+bool mapGraphFile(const string& fileName, sGraph* graph, ostream& messages) {
+	struct stat st;
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		messages << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < GRAPH_FILE_V2_HEADER_SIZE) {
+		messages << "Graph file \"" << fileName << "\" is truncated" << endl;
+		close(fd);
+		return EXIT_FAILURE;
+	}
+	void* base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) {
+		messages << "Unable to map file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+
+	const sGraphFileHeader* header = (const sGraphFileHeader*)base;
+	// Version 2 headers end before costType
+	const uint32_t costType = (header->version == 2) ? COST_INT32 : header->costType;
+	const char* error = NULL;
+	if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0)
+		error = "is not a graph file";
+	else if (header->byteOrder != GRAPH_FILE_BYTE_ORDER)
+		error = "was written on a machine with a different byte order";
+	else if (header->version != GRAPH_FILE_VERSION && header->version != 2)
+		error = "has an unsupported version, convert it again";
+	else if (header->version != 2 && (uint64_t)st.st_size < sizeof(sGraphFileHeader))
+		error = "is truncated";
+	else if (costType != COST_INT32 && costType != COST_UINT16)
+		error = "has an unknown cost type";
+	else if (header->numOfNodes > 0xFFFFFFFEu)
+		error = "is too large for 32-bit vertex ids";
+	// Every position and count is bounded by the file size first, so the
+	// array ends below can't overflow
+	else if (header->fileSize != (uint64_t)st.st_size
+			|| header->offsetsPos > header->fileSize || header->adjVertexPos > header->fileSize
+			|| header->adjCostPos > header->fileSize || header->numOfEdges > header->fileSize / sizeof(uint32_t)
+			|| header->offsetsPos % GRAPH_FILE_ALIGNMENT || header->adjVertexPos % GRAPH_FILE_ALIGNMENT
+			|| header->adjCostPos % GRAPH_FILE_ALIGNMENT
+			|| header->offsetsPos + (header->numOfNodes + 1) * sizeof(uint64_t) > header->adjVertexPos
+			|| header->adjVertexPos + 2 * header->numOfEdges * sizeof(uint32_t) > header->adjCostPos
+			|| header->adjCostPos + 2 * header->numOfEdges * costSize(costType) > header->fileSize)
+		error = "has a corrupt header";
+	if (error) {
+		messages << "Graph file \"" << fileName << "\" " << error << endl;
+		munmap(base, st.st_size);
+		return EXIT_FAILURE;
+	}
+
+	releaseGraph(graph);
+	graph->mappedBase = base;
+	graph->mappedSize = st.st_size;
+	graph->numOfNodes = header->numOfNodes;
+	graph->numOfEdges = header->numOfEdges;
+	graph->offsets = (const uint64_t*)((const char*)base + header->offsetsPos);
+	graph->adjVertex = (const uint*)((const char*)base + header->adjVertexPos);
+	graph->costType = (eCostType)costType;
+	if (costType == COST_UINT16)
+		graph->adjCost16 = (const uint16_t*)((const char*)base + header->adjCostPos);
+	else
+		graph->adjCost = (const int*)((const char*)base + header->adjCostPos);
+
+	/*
+	 * The solvers index with the arrays as they are, so one pass over them
+	 * checks that the rows are in order, end at the last slot and that
+	 * every neighbour is a vertex
+	 */
+	const uint64_t numOfSlots = 2 * graph->numOfEdges;
+	bool bDescending = graph->offsets[0] != 0 || graph->offsets[graph->numOfNodes] != numOfSlots;
+	for (uint v = 0; v < graph->numOfNodes; v++)
+		bDescending |= graph->offsets[v] > graph->offsets[v+1];
+	uint maxVertex = 0;
+	for (uint64_t e = 0; e < numOfSlots; e++)
+		maxVertex = max(maxVertex, graph->adjVertex[e]);
+	if (bDescending)
+		error = "has a corrupt offsets array";
+	else if (numOfSlots > 0 && maxVertex >= graph->numOfNodes)
+		error = "has a neighbour out of range";
+	if (error) {
+		messages << "Graph file \"" << fileName << "\" " << error << endl;
+		releaseGraph(graph);
+		return EXIT_FAILURE;
+	}
+#ifdef LOG_ON
+	messages << "Mapped graph with " << graph->numOfNodes << " vertices and " << graph->numOfEdges << " edges" << endl;
+#endif
+	return EXIT_SUCCESS;
+}
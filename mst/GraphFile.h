@@ -0,0 +1,66 @@
+/*
+ * GraphFile.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef GRAPHFILE_H_
+#define GRAPHFILE_H_
+
+#include <string>
+#include <fstream>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+
+#define GRAPH_FILE_MAGIC "MSTCSR\r\n"
+#define GRAPH_FILE_VERSION 3
+// Written as is, reads back differently on a machine of the other byte order
+#define GRAPH_FILE_BYTE_ORDER 0x01020304u
+// Every array starts on a cache line
+#define GRAPH_FILE_ALIGNMENT 64
+
+/*
+ * Binary graph file layout (version 3, all fields in host byte order):
+ *
+ *   sGraphFileHeader
+ *   offsets    uint64[numOfNodes+1]
+ *   adjVertex  uint32[2*numOfEdges]
+ *   adjCost    int32[2*numOfEdges], or uint16 if costType is COST_UINT16
+ *
+ * Each array starts at the file position recorded in the header, aligned to
+ * GRAPH_FILE_ALIGNMENT, so a read-only mapping of the file can be used as
+ * the CSR graph without copying or parsing anything. Version 2 files have
+ * no costType and always int32 costs. Version 1 files had 32-bit offsets
+ * and have to be converted again.
+ */
+struct sGraphFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t numOfNodes;
+	uint64_t numOfEdges;
+	uint64_t offsetsPos;
+	uint64_t adjVertexPos;
+	uint64_t adjCostPos;
+	uint64_t fileSize;
+	// eCostType of adjCost, version 3 on
+	uint32_t costType;
+	uint32_t reserved;
+};
+
+// Header size of version 2 files, which ended at fileSize
+#define GRAPH_FILE_V2_HEADER_SIZE 64
+
+// Rounds pos up to the next multiple of GRAPH_FILE_ALIGNMENT
+inline uint64_t alignPos(uint64_t pos) {
+	return (pos + GRAPH_FILE_ALIGNMENT - 1) & ~(uint64_t)(GRAPH_FILE_ALIGNMENT - 1);
+}
+
+bool isGraphFile(const string& fileName);
+bool writeGraphFile(const string& fileName, const sGraph* graph);
+bool mapGraphFile(const string& fileName, sGraph* graph, ostream& messages);
+void writeAligned(ofstream& file, const void* data, uint64_t size);
+
+#endif /* GRAPHFILE_H_ */
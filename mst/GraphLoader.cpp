@@ -0,0 +1,271 @@
+/*
+ * GraphLoader.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "GraphLoader.h"
+#include "Parallel.h"
+
+// What one thread found in its chunk of the edge lines
+struct sLoadChunk {
+	const char* begin;
+	const char* end;
+	vector<sEdge> vEdges;
+	uint64_t numOfLines;
+	uint64_t numOfSelfLoops;
+	// First error of the chunk, errorLine is relative to the chunk
+	const char* error;
+	uint64_t errorLine;
+
+	sLoadChunk():
+		begin(NULL),end(NULL),numOfLines(0),numOfSelfLoops(0),error(NULL),errorLine(0) {}
+};
+
+// Post increment of a shared counter. A single thread skips the locked add
+static inline uint64_t bump(atomic<uint64_t>& counter, const bool bShared) {
+	if (bShared)
+		return counter.fetch_add(1, memory_order_relaxed);
+	const uint64_t value = counter.load(memory_order_relaxed);
+	counter.store(value + 1, memory_order_relaxed);
+	return value;
+}
+
+/*
+ * Parses the "v1 v2 cost" lines of one chunk. Vertex ids are checked
+ * against the header and self loops are dropped.
+ */
+static void parseChunk(sLoadChunk& chunk, const uint numOfNodes) {
+	const char* p = chunk.begin;
+	const char* end = chunk.end;
+	sEdge e1;
+	uint v1, v2;
+	int cost;
+
+	chunk.vEdges.reserve((end - p) / 12);
+	while (p < end) {
+		p = skipBlanks(p, end);
+		if (p < end && *p == '\n') {
+			// Empty line
+			p++;
+			chunk.numOfLines++;
+			continue;
+		}
+		if (p == end)
+			break;
+
+		const char* q = parseNumber(p, end, v1);
+		if (q) q = parseNumber(q, end, v2);
+		if (q) q = parseNumber(q, end, cost);
+		if (q) q = skipBlanks(q, end);
+		if (!q || (q < end && *q != '\n')) {
+			chunk.error = "expected \"v1 v2 cost\"";
+			chunk.errorLine = chunk.numOfLines;
+			return;
+		}
+		if (v1 >= numOfNodes || v2 >= numOfNodes) {
+			chunk.error = "vertex id out of range";
+			chunk.errorLine = chunk.numOfLines;
+			return;
+		}
+		p = (q < end) ? q + 1 : q;
+		chunk.numOfLines++;
+
+		if (v1 == v2) {
+			chunk.numOfSelfLoops++;
+			continue;
+		}
+		e1.vertexStart = v1;
+		e1.vertexEnd = v2;
+		e1.cost = cost;
+		chunk.vEdges.push_back(e1);
+	}
+}
+
+/*
+ * Loads a text graph ("n m" header followed by "v1 v2 cost" lines).
+ *   1. The file is mapped and split into one chunk per thread at line ends.
+ *   2. Every thread parses its chunk with from_chars into a local edge list.
+ *   3. Vertex degrees are counted in parallel, turned into CSR offsets and
+ *      both directions of every edge are scattered into their rows.
+ *   4. Every row is sorted by neighbour and parallel edges are dropped,
+ *      keeping the cheapest one.
+ * Errors and the counts of dropped edges and self loops go to messages.
+ */
+bool loadTextGraph(const string& fileName, sGraph* graph, uint numOfThreads, ostream& messages) {
+	struct stat st;
+	uint numOfNodes = 0;
+	uint64_t numOfHeaderEdges = 0;
+
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		messages << "Unable to open file \"" << fileName << "\"" << endl;
+		if (fd >= 0)
+			close(fd);
+		return EXIT_FAILURE;
+	}
+	if (st.st_size == 0) {
+		messages << "File \"" << fileName << "\" is empty" << endl;
+		close(fd);
+		return EXIT_FAILURE;
+	}
+	void* base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) {
+		messages << "Unable to map file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	madvise(base, st.st_size, MADV_SEQUENTIAL);
+	const char* data = (const char*)base;
+	const char* dataEnd = data + st.st_size;
+
+	// Header line: number of nodes and number of edges
+	const char* p = parseNumber(data, dataEnd, numOfNodes);
+	if (p) p = parseNumber(p, dataEnd, numOfHeaderEdges);
+	if (!p || numOfNodes == 0xFFFFFFFFu) {
+		messages << "File \"" << fileName << "\": expected \"n m\" with n < 2^32-1 on line 1" << endl;
+		munmap(base, st.st_size);
+		return EXIT_FAILURE;
+	}
+	p = (const char*)memchr(p, '\n', dataEnd - p);
+	p = p ? p + 1 : dataEnd;
+
+	// Chunk boundaries, moved forward to the start of the next line
+	if (numOfThreads == 0)
+		numOfThreads = 1;
+	vector<sLoadChunk> chunks(numOfThreads);
+	const size_t bodySize = dataEnd - p;
+	for (uint t = 0; t < numOfThreads; t++) {
+		const char* begin = (t == 0) ? p : chunks[t-1].end;
+		const char* end = p + bodySize * (t + 1) / numOfThreads;
+		if (end < begin)
+			end = begin;
+		if (t + 1 == numOfThreads) {
+			end = dataEnd;
+		} else {
+			const char* nl = (const char*)memchr(end, '\n', dataEnd - end);
+			end = nl ? nl + 1 : dataEnd;
+		}
+		chunks[t].begin = begin;
+		chunks[t].end = end;
+	}
+
+	parallelRun(numOfThreads, [&](uint t) {
+		parseChunk(chunks[t], numOfNodes);
+	});
+	munmap(base, st.st_size);
+
+	uint64_t numOfLines = 1, numOfSelfLoops = 0;
+	for (uint t = 0; t < numOfThreads; t++) {
+		if (chunks[t].error) {
+			messages << "File \"" << fileName << "\": " << chunks[t].error << " on line "
+				 << numOfLines + chunks[t].errorLine + 1 << endl;
+			return EXIT_FAILURE;
+		}
+		numOfLines += chunks[t].numOfLines;
+		numOfSelfLoops += chunks[t].numOfSelfLoops;
+	}
+
+	// Count degrees
+	releaseGraph(graph);
+	const bool bShared = numOfThreads > 1;
+	vector< atomic<uint64_t> > fill(numOfNodes + 1);
+	parallelRun(numOfThreads, [&](uint t) {
+		const vector<sEdge>& vEdges = chunks[t].vEdges;
+		for (size_t i = 0; i < vEdges.size(); i++) {
+			bump(fill[vEdges[i].vertexStart], bShared);
+			bump(fill[vEdges[i].vertexEnd], bShared);
+		}
+	});
+
+	// Prefix sum, fill[v] becomes the next free slot of vertex v
+	vector<uint64_t>& offsets = graph->vOffsets;
+	offsets.resize(numOfNodes + 1);
+	uint64_t sum = 0;
+	for (uint v = 0; v < numOfNodes; v++) {
+		offsets[v] = sum;
+		sum += fill[v].load(memory_order_relaxed);
+		fill[v].store(offsets[v], memory_order_relaxed);
+	}
+	offsets[numOfNodes] = sum;
+
+	// Scatter both directions
+	graph->vAdjVertex.resize(sum);
+	graph->vAdjCost.resize(sum);
+	parallelRun(numOfThreads, [&](uint t) {
+		vector<sEdge>& vEdges = chunks[t].vEdges;
+		for (size_t i = 0; i < vEdges.size(); i++) {
+			const sEdge& e = vEdges[i];
+			uint64_t slot = bump(fill[e.vertexStart], bShared);
+			graph->vAdjVertex[slot] = e.vertexEnd;
+			graph->vAdjCost[slot] = e.cost;
+			slot = bump(fill[e.vertexEnd], bShared);
+			graph->vAdjVertex[slot] = e.vertexStart;
+			graph->vAdjCost[slot] = e.cost;
+		}
+		vector<sEdge>().swap(vEdges);
+	});
+
+	// Sort rows by neighbour and mark parallel edges, keeping the cheapest
+	vector<uint64_t> rowSize(numOfNodes);
+	atomic<size_t> numOfDuplicates(0);
+	parallelFor(numOfThreads, numOfNodes, [&](uint, size_t begin, size_t end) {
+		// (neighbour, cost) packed into one integer, cost with its sign bit
+		// flipped so that it orders like a signed number
+		vector<uint64_t> row;
+		size_t duplicates = 0;
+		for (size_t v = begin; v < end; v++) {
+			const uint64_t first = offsets[v], last = offsets[v+1];
+			row.clear();
+			for (uint64_t e = first; e < last; e++)
+				row.push_back((uint64_t)graph->vAdjVertex[e] << 32 | ((uint)graph->vAdjCost[e] ^ 0x80000000u));
+			sort(row.begin(), row.end());
+			uint64_t kept = 0;
+			for (size_t i = 0; i < row.size(); i++) {
+				const uint w = row[i] >> 32;
+				if (kept > 0 && w == graph->vAdjVertex[first + kept - 1])
+					continue;
+				graph->vAdjVertex[first + kept] = w;
+				graph->vAdjCost[first + kept] = (int)((uint)row[i] ^ 0x80000000u);
+				kept++;
+			}
+			rowSize[v] = kept;
+			duplicates += row.size() - kept;
+		}
+		numOfDuplicates.fetch_add(duplicates);
+	});
+
+	// Close the gaps left by parallel edges
+	if (numOfDuplicates > 0) {
+		uint64_t next = 0;
+		for (uint v = 0; v < numOfNodes; v++) {
+			const uint64_t first = offsets[v];
+			memmove(&graph->vAdjVertex[next], &graph->vAdjVertex[first], rowSize[v] * sizeof(uint));
+			memmove(&graph->vAdjCost[next], &graph->vAdjCost[first], rowSize[v] * sizeof(int));
+			offsets[v] = next;
+			next += rowSize[v];
+		}
+		offsets[numOfNodes] = next;
+		graph->vAdjVertex.resize(next);
+		graph->vAdjCost.resize(next);
+		messages << "Dropped " << numOfDuplicates / 2 << " parallel edges" << endl;
+	}
+	if (numOfSelfLoops > 0)
+		messages << "Dropped " << numOfSelfLoops << " self loops" << endl;
+
+	graph->numOfNodes = numOfNodes;
+	graph->numOfEdges = offsets[numOfNodes] / 2;
+	compactCosts(graph);
+#ifdef LOG_ON
+	messages << "Loaded " << numOfLines << " lines, header says " << numOfHeaderEdges << " edges" << endl;
+#endif
+	return EXIT_SUCCESS;
+}
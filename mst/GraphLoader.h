@@ -0,0 +1,34 @@
+/*
+ * GraphLoader.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef GRAPHLOADER_H_
+#define GRAPHLOADER_H_
+
+#include <string>
+#include <charconv>
+#include "Global.h"
+#include "Graph.h"
+
+inline const char* skipBlanks(const char* p, const char* end) {
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+		p++;
+	return p;
+}
+
+// Parses one number after optional blanks. Returns NULL on malformed input
+template <class T>
+inline const char* parseNumber(const char* p, const char* end, T& value) {
+	p = skipBlanks(p, end);
+	from_chars_result r = from_chars(p, end, value);
+	if (r.ec != errc() || r.ptr == p)
+		return NULL;
+	return r.ptr;
+}
+
+bool loadTextGraph(const string& fileName, sGraph* graph, uint numOfThreads, ostream& messages);
+
+#endif /* GRAPHLOADER_H_ */
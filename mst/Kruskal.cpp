@@ -0,0 +1,131 @@
+/*
+ * Kruskal.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include "Kruskal.h"
+
+/*
+ * Collects every undirected edge of the CSR graph once (vertexStart < vertexEnd)
+ */
+void buildEdgeList(const sGraph* graph, vector<sEdge>& vEdges) {
+	sEdge e1;
+	vEdges.clear();
+	vEdges.reserve(graph->numOfEdges);
+	for (uint v = 0; v < graph->numOfNodes; v++) {
+		for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++) {
+			if (v < graph->adjVertex[e]) {
+				e1.vertexStart = v;
+				e1.vertexEnd = graph->adjVertex[e];
+				e1.cost = graph->cost(e);
+				vEdges.push_back(e1);
+			}
+		}
+	}
+}
+
+void sortEdgesByCost(vector<sEdge>& vEdges) {
+	sortEdgeRange(vEdges.begin(), vEdges.end());
+}
+
+/*
+ * Scans cost sorted edges and keeps the ones joining two components.
+ * Stops as soon as the tree has numOfNodes-1 edges.
+ */
+static void kruskalScan(vector<sEdge>::iterator first, vector<sEdge>::iterator last,
+		sDisjointSet& components, vector<sEdge>& vMstOutput, const uint numOfNodes) {
+	for (; first != last && vMstOutput.size() + 1 < numOfNodes; first++) {
+		if (components.unite(first->vertexStart, first->vertexEnd))
+			vMstOutput.push_back(*first);
+	}
+}
+
+/*
+ * Filter-Kruskal: partition the range around a pivot cost, solve the light
+ * part first and drop every heavy edge that already lies inside a component
+ * before the heavy part is sorted. On dense graphs most heavy edges are
+ * filtered and never sorted at all. Works in place on the edge list.
+ */
+static void filterKruskal(vector<sEdge>::iterator first, vector<sEdge>::iterator last,
+		sDisjointSet& components, vector<sEdge>& vMstOutput, const uint numOfNodes) {
+	if (vMstOutput.size() + 1 >= numOfNodes || first == last)
+		return;
+	const size_t size = last - first;
+	if (size <= FILTER_KRUSKAL_CUTOFF) {
+		sortEdgeRange(first, last);
+		kruskalScan(first, last, components, vMstOutput, numOfNodes);
+		return;
+	}
+
+	// Median of three sampled costs as pivot
+	int a = first->cost, b = (first + size/2)->cost, c = (last - 1)->cost;
+	const int pivot = max(min(a,b), min(max(a,b),c));
+
+	vector<sEdge>::iterator middle = first;
+	for (vector<sEdge>::iterator it = first; it != last; it++) {
+		if (it->cost <= pivot)
+			swap(*it, *middle++);
+	}
+	if (middle == last) {
+		// All costs at or below the pivot, partitioning does not make progress
+		sortEdgeRange(first, last);
+		kruskalScan(first, last, components, vMstOutput, numOfNodes);
+		return;
+	}
+	filterKruskal(first, middle, components, vMstOutput, numOfNodes);
+
+	// Filter: keep only heavy edges that still connect two components
+	vector<sEdge>::iterator kept = middle;
+	for (vector<sEdge>::iterator it = middle; it != last; it++) {
+		if (components.find(it->vertexStart) != components.find(it->vertexEnd))
+			*kept++ = *it;
+	}
+	filterKruskal(middle, kept, components, vMstOutput, numOfNodes);
+}
+
+/* Algorithm :
+		1.	Build the list of all edges and sort it by cost (linear time, costs are bounded).
+		2.	Put every vertex in its own set.
+		3.	Scan edges in increasing cost. Accept an edge if its end points are
+			in different sets and merge the two sets.
+		4.	Stop once n-1 edges are accepted.
+*/
+bool generateMSTKruskalScheme(const sGraph* graph, bool bFilter, sMstResult* result) {
+	const uint numOfNodes = graph->numOfNodes;
+	struct timeval start, end;
+	long seconds, useconds;
+	vector<sEdge> vEdges;
+	// The tree with n-1 items
+	vector<sEdge>& vMstOutput = result->vEdges;
+	sDisjointSet components(numOfNodes);
+	int64_t totalCost = 0;
+
+	// Start recording the time
+	gettimeofday(&start, NULL);
+
+	vMstOutput.reserve(numOfNodes);
+	buildEdgeList(graph, vEdges);
+	if (bFilter) {
+		filterKruskal(vEdges.begin(), vEdges.end(), components, vMstOutput, numOfNodes);
+	}
+	else {
+		sortEdgesByCost(vEdges);
+		kruskalScan(vEdges.begin(), vEdges.end(), components, vMstOutput, numOfNodes);
+	}
+	for (vector<sEdge>::const_iterator it = vMstOutput.begin(); it != vMstOutput.end(); it++)
+		totalCost += it->cost;
+
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = totalCost;
+
+	// Fewer edges are a spanning forest, which only --forest asks for
+	if (vMstOutput.size() + 1 < numOfNodes) {
+		result->strError = "Graph is not connected, it has no spanning tree";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
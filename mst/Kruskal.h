@@ -0,0 +1,73 @@
+/*
+ * Kruskal.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef KRUSKAL_H_
+#define KRUSKAL_H_
+
+#include <iostream>
+#include <iterator>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+#include "DisjointSet.h"
+
+// Below this many edges filter-Kruskal stops partitioning and sorts
+#define FILTER_KRUSKAL_CUTOFF 4096
+
+/*
+ * Stable linear time sort on the edge cost. Costs are bounded integers, so a
+ * counting sort over [minCost, maxCost] is used when that range is not much
+ * larger than the edge list, and a two pass 16-bit LSD radix sort otherwise.
+ * Works on any edge type with a cost member, the run edges of ExternalMst too.
+ */
+template <class Iterator>
+void sortEdgeRange(Iterator first, Iterator last) {
+	typedef typename iterator_traits<Iterator>::value_type Edge;
+	const size_t size = last - first;
+	if (size < 2)
+		return;
+
+	int minCost = first->cost, maxCost = first->cost;
+	for (Iterator it = first; it != last; it++) {
+		minCost = min(minCost, it->cost);
+		maxCost = max(maxCost, it->cost);
+	}
+	// 64-bit, the costs may span the whole int range
+	const uint64_t range = (int64_t)maxCost - minCost + 1;
+	vector<Edge> vSorted(size);
+
+	if (range <= max((uint64_t)MAX_COST, (uint64_t)2 * size)) {
+		// Counting sort
+		vector<size_t> counts(range + 1, 0);
+		for (Iterator it = first; it != last; it++)
+			counts[(uint)it->cost - (uint)minCost + 1]++;
+		for (uint64_t i = 0; i < range; i++)
+			counts[i+1] += counts[i];
+		for (Iterator it = first; it != last; it++)
+			vSorted[counts[(uint)it->cost - (uint)minCost]++] = *it;
+		copy(vSorted.begin(), vSorted.end(), first);
+		return;
+	}
+
+	// LSD radix sort on the 32-bit cost offset, 16 bits per pass
+	for (uint shift = 0; shift < 32; shift += 16) {
+		vector<size_t> counts(65536 + 1, 0);
+		for (Iterator it = first; it != last; it++)
+			counts[(((uint)it->cost - (uint)minCost) >> shift & 0xFFFF) + 1]++;
+		for (uint i = 0; i < 65536; i++)
+			counts[i+1] += counts[i];
+		for (Iterator it = first; it != last; it++)
+			vSorted[counts[((uint)it->cost - (uint)minCost) >> shift & 0xFFFF]++] = *it;
+		copy(vSorted.begin(), vSorted.end(), first);
+	}
+}
+
+void buildEdgeList(const sGraph* graph, vector<sEdge>& vEdges);
+void sortEdgesByCost(vector<sEdge>& vEdges);
+bool generateMSTKruskalScheme(const sGraph* graph, bool bFilter, sMstResult* result);
+
+#endif /* KRUSKAL_H_ */
@@ -0,0 +1,194 @@
+/*
+ * LinkCutTree.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef LINKCUTTREE_H_
+#define LINKCUTTREE_H_
+
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+/*
+ * Link-cut tree (Sleator and Tarjan) over nodes 1..n, node 0 is the empty
+ * node. Every node carries a key and each splay tree keeps the node with
+ * the largest key below it, so the heaviest node on the path between two
+ * nodes is found in O(log n) amortised, as are link, cut and connected.
+ * Paths are kept in splay trees ordered by depth, with a lazy flip flag to
+ * reroot a tree.
+ */
+struct sLinkCutTree {
+	struct sNode {
+		uint child[2];
+		uint parent;
+		// Node with the largest key in this splay subtree
+		uint maxNode;
+		bool bFlip;
+	};
+	vector<sNode> nodes;
+	vector<uint64_t> keys;
+
+	sLinkCutTree() { resize(0); }
+
+	// Grows to nodes 1..n, new nodes are single node trees with key 0
+	void resize(uint n) {
+		const uint first = nodes.size();
+		sNode empty = { { 0, 0 }, 0, 0, false };
+		nodes.resize(n + 1, empty);
+		keys.resize(n + 1, 0);
+		for (uint x = max(first, 1u); x <= n; x++)
+			nodes[x].maxNode = x;
+	}
+
+	// Heaviest node on the path between a and b, 0 if they aren't connected
+	uint pathMax(uint a, uint b) {
+		makeRoot(a);
+		// findRoot leaves a as the splay root of the path a..b
+		if (findRoot(b) != a)
+			return 0;
+		return nodes[a].maxNode;
+	}
+
+	// Makes the nodes of a path, topmost first, one balanced splay tree and
+	// hangs it below pathParent. Building a tree from heavy paths this way
+	// keeps the first accesses O(log^2 n) instead of O(depth)
+	void buildPath(const uint* path, size_t count, uint pathParent) {
+		const uint root = buildRange(path, 0, count);
+		if (root)
+			nodes[root].parent = pathParent;
+	}
+
+	// Joins the trees of a and b with the edge a-b
+	void link(uint a, uint b) {
+		makeRoot(a);
+		nodes[a].parent = b;
+	}
+
+	// Removes the edge a-b, which must be in the tree
+	void cut(uint a, uint b) {
+		makeRoot(a);
+		access(b);
+		// a is now the only node above b on the path
+		nodes[b].child[0] = 0;
+		nodes[a].parent = 0;
+		update(b);
+	}
+
+	// Changes the key of x, the path aggregates above it are refreshed
+	void setKey(uint x, uint64_t key) {
+		access(x);
+		keys[x] = key;
+		update(x);
+	}
+
+private:
+	inline bool isSplayRoot(uint x) const {
+		const uint p = nodes[x].parent;
+		return p == 0 || (nodes[p].child[0] != x && nodes[p].child[1] != x);
+	}
+
+	inline void update(uint x) {
+		sNode& n = nodes[x];
+		uint best = x;
+		if (n.child[0] && keys[nodes[n.child[0]].maxNode] > keys[best])
+			best = nodes[n.child[0]].maxNode;
+		if (n.child[1] && keys[nodes[n.child[1]].maxNode] > keys[best])
+			best = nodes[n.child[1]].maxNode;
+		n.maxNode = best;
+	}
+
+	inline void pushDown(uint x) {
+		sNode& n = nodes[x];
+		if (n.bFlip) {
+			swap(n.child[0], n.child[1]);
+			if (n.child[0])
+				nodes[n.child[0]].bFlip ^= true;
+			if (n.child[1])
+				nodes[n.child[1]].bFlip ^= true;
+			n.bFlip = false;
+		}
+	}
+
+	void rotate(uint x) {
+		const uint p = nodes[x].parent, g = nodes[p].parent;
+		const uint side = nodes[p].child[1] == x;
+		const uint inner = nodes[x].child[side ^ 1];
+		if (!isSplayRoot(p))
+			nodes[g].child[nodes[g].child[1] == p] = x;
+		nodes[x].parent = g;
+		nodes[x].child[side ^ 1] = p;
+		nodes[p].parent = x;
+		nodes[p].child[side] = inner;
+		if (inner)
+			nodes[inner].parent = p;
+		update(p);
+		update(x);
+	}
+
+	void splay(uint x) {
+		// Flips are pushed down from the splay root first
+		path.clear();
+		for (uint y = x; ; y = nodes[y].parent) {
+			path.push_back(y);
+			if (isSplayRoot(y))
+				break;
+		}
+		for (size_t i = path.size(); i-- > 0; )
+			pushDown(path[i]);
+
+		while (!isSplayRoot(x)) {
+			const uint p = nodes[x].parent, g = nodes[p].parent;
+			if (!isSplayRoot(p))
+				rotate((nodes[g].child[1] == p) == (nodes[p].child[1] == x) ? p : x);
+			rotate(x);
+		}
+	}
+
+	// Makes the path from the root to x preferred, x ends up as splay root
+	void access(uint x) {
+		for (uint last = 0, y = x; y; last = y, y = nodes[y].parent) {
+			splay(y);
+			nodes[y].child[1] = last;
+			update(y);
+		}
+		splay(x);
+	}
+
+	void makeRoot(uint x) {
+		access(x);
+		nodes[x].bFlip ^= true;
+	}
+
+	uint findRoot(uint x) {
+		access(x);
+		for (pushDown(x); nodes[x].child[0]; pushDown(x))
+			x = nodes[x].child[0];
+		splay(x);
+		return x;
+	}
+
+	// Balanced splay tree over path[begin, end), returns its root
+	uint buildRange(const uint* path, size_t begin, size_t end) {
+		if (begin == end)
+			return 0;
+		const size_t middle = begin + (end - begin) / 2;
+		const uint x = path[middle];
+		nodes[x].child[0] = buildRange(path, begin, middle);
+		nodes[x].child[1] = buildRange(path, middle + 1, end);
+		for (uint side = 0; side < 2; side++)
+			if (nodes[x].child[side])
+				nodes[nodes[x].child[side]].parent = x;
+		update(x);
+		return x;
+	}
+
+	// Splay path scratch, kept to avoid allocating on every splay
+	vector<uint> path;
+};
+
+#endif /* LINKCUTTREE_H_ */
@@ -14,8 +14,34 @@
 int main(int argc, char **argv) {
 	//vector - range constructor
 	vector<string> args(argv + 1, argv + argc);
-	string strFileName;
+	string strFileName, strOutFileName, error;
 	stringstream ss;
+	sGraph graph;
+	sMstOptions options;
+	sOutputConfig outputConfig;
+	sMstResult result;
+	bool bUserInputMode = false, bConvertMode = false, bCompressMode = false, bBatchMode = false;
+	bool bExternalMode = false, bVerify = false, bVerifyTreeMode = false;
+	// Tree file checked against the graph by --verify-tree
+	string strTreeFile;
+	// Memory budget and run file directory given by --memory and --temp
+	sExternalOptions externalOptions;
+	// Result cache directory and size bound given by --cache and --cache-size
+	sResultCache cache;
+	// Output mode name and file given by --output and -o
+	string strOutputMode = "text", strOutputFile;
+	// Vertex renumbering given by --reorder
+	string strReorder = "none";
+	int numOfNodes = 0;
+	// Density of the random graph in percent, may be fractional for sparse graphs
+	double density = 0;
+	// Seed of the random graph, the time if --seed isn't given
+	uint64_t seed = 0;
+	bool bSeedGiven = false;
+	// Delta files applied one batch each to the tree of a loaded graph
+	vector<string> vDeltaFiles;
+	// Options given that only some schemes take, checked once the scheme is known
+	vector<string> vSchemeOptions;
 
 	if (argc == 1){
 		printHelp();
@@ -31,11 +57,115 @@ int main(int argc, char **argv) {
 		else if (*i == "-s") {
 			strFileName = *++i;
 			bUserInputMode = true;
-			bSimpleScheme = true;
+			options.scheme = SIMPLE_SCHEME;
 		}
 		else if (*i == "-f") {
 			strFileName = *++i;
 			bUserInputMode = true;
+			options.scheme = HEAP_SCHEME;
+		}
+		else if (*i == "-k") {
+			strFileName = *++i;
+			bUserInputMode = true;
+			options.scheme = KRUSKAL_SCHEME;
+		}
+		else if (*i == "-b") {
+			strFileName = *++i;
+			bUserInputMode = true;
+			options.scheme = BORUVKA_SCHEME;
+		}
+		else if (*i == "-d") {
+			strFileName = *++i;
+			bUserInputMode = true;
+			options.scheme = DENSE_SCHEME;
+		}
+		else if (*i == "--convert") {
+			strFileName = *++i;
+			strOutFileName = *++i;
+			bConvertMode = true;
+		}
+		else if (*i == "--compress") {
+			strFileName = *++i;
+			strOutFileName = *++i;
+			bCompressMode = true;
+		}
+		else if (*i == "--verify") {
+			bVerify = true;
+		}
+		else if (*i == "--verify-tree") {
+			strFileName = *++i;
+			strTreeFile = *++i;
+			bVerifyTreeMode = true;
+		}
+		else if (*i == "--external") {
+			strFileName = *++i;
+			bExternalMode = true;
+		}
+		else if (*i == "--memory") {
+			ss.str(*++i);
+			ss >> externalOptions.memoryBudget;
+			externalOptions.memoryBudget <<= 20;
+			ss.clear();
+		}
+		else if (*i == "--temp") {
+			externalOptions.strTempDir = *++i;
+		}
+		else if (*i == "--cache") {
+			cache.strDir = *++i;
+		}
+		else if (*i == "--cache-size") {
+			ss.str(*++i);
+			ss >> cache.maxBytes;
+			cache.maxBytes <<= 20;
+			ss.clear();
+		}
+		else if (*i == "--batch") {
+			strFileName = *++i;
+			bBatchMode = true;
+		}
+		else if (*i == "--delta") {
+			vDeltaFiles.push_back(*++i);
+		}
+		else if (*i == "-t") {
+			ss.str(*++i);
+			ss >> options.numOfThreads;
+			ss.clear();
+		}
+		else if (*i == "--filter") {
+			options.bFilterKruskal = true;
+			vSchemeOptions.push_back(*i);
+		}
+		else if (*i == "--forest") {
+			options.bForest = true;
+		}
+		else if (*i == "--reorder") {
+			strReorder = *++i;
+		}
+		else if (*i == "--seed") {
+			ss.str(*++i);
+			ss >> seed;
+			ss.clear();
+			bSeedGiven = true;
+		}
+		else if (*i == "--output") {
+			strOutputMode = *++i;
+		}
+		else if (*i == "-o") {
+			strOutputFile = *++i;
+		}
+		else if (*i == "--insert") {
+			vSchemeOptions.push_back(*i);
+			options.bEagerInsert = (*++i == "eager");
+		}
+		else if (*i == "--heap") {
+			vSchemeOptions.push_back(*i);
+			options.strHeapName = *++i;
+		}
+		else if (*i == "--bucket-limit") {
+			vSchemeOptions.push_back(*i);
+			ss.str(*++i);
+			ss >> options.maxBucketKey;
+			ss.clear();
 		}
 		else if (*i == "-r") {
 			ss.str(*++i);
@@ -49,44 +179,129 @@ int main(int argc, char **argv) {
 		}
 	}
 	ss.flush();
+	if(bBatchMode) {
+		// Batch mode
+		// Runs every job of the manifest on a thread pool, -o names the results file
+		return runBatch(strFileName,strOutputFile,options.numOfThreads ? options.numOfThreads : defaultThreadCount());
+	}
+	if(setOutputMode(strOutputMode,strOutputFile,&outputConfig)) {
+		printHelp();
+		return EXIT_FAILURE;
+	}
+	if(parseReorder(strReorder,&options.reorder)) {
+		cout << "Unknown reordering \"" << strReorder << "\"" << endl;
+		printHelp();
+		return EXIT_FAILURE;
+	}
+	if(bExternalMode && bVerify) {
+		cout << "--verify needs the whole tree in memory, it doesn't work with --external" << endl;
+		return EXIT_FAILURE;
+	}
+	if(bExternalMode) {
+		// External mode
+		// Streams the edge file through sorted runs on disk, the tree goes out as it's found
+		externalOptions.bForest = options.bForest;
+		return runExternalMst(strFileName,externalOptions,outputConfig);
+	}
+	if(!bConvertMode && !bCompressMode && !bVerifyTreeMode && checkMstOptions(options,&error)) {
+		cout << error << endl;
+		printHelp();
+		return EXIT_FAILURE;
+	}
+	for(size_t i = 0; bUserInputMode && i < vSchemeOptions.size(); i++) {
+		if(checkSchemeOption(options.scheme,vSchemeOptions[i],&error)) {
+			cout << error << endl;
+			printHelp();
+			return EXIT_FAILURE;
+		}
+	}
+	const uint numOfThreads = options.numOfThreads ? options.numOfThreads : defaultThreadCount();
+	// Graph the tree of a scheme is checked against, --verify only
+	const sGraph* verifyGraph = bVerify ? &graph : NULL;
 
 	//Start processing as per the arguments
-	if(bUserInputMode) {
+	if(bConvertMode) {
+		// Convert mode
+		// Reads a text graph and writes it as a binary graph file
+		if(!populateDataFromFile(&strFileName,&graph,numOfThreads))
+			return writeGraphFile(strOutFileName,&graph);
+	}
+	else if(bCompressMode) {
+		// Compress mode
+		// Writes a graph in the compressed graph format, see CompressedGraph.h
+		if(!populateDataFromFile(&strFileName,&graph,numOfThreads))
+			return writeCompressedGraph(strOutFileName,&graph);
+	}
+	else if(bVerifyTreeMode) {
+		// Verify mode
+		// Checks a tree written by an earlier run against its graph
+		if(!populateDataFromFile(&strFileName,&graph,numOfThreads))
+			return verifyTreeFile(&graph,strTreeFile,options.bForest);
+	}
+	else if(bUserInputMode) {
 		// User input mode
-		// Populates data from file and generates a graph into vertices
-		if(!populateDataFromFile(&strFileName,vertices)) {
+		// With --cache the tree is looked up by the content of the file and the
+		// options first, a hit needs the graph only for --verify and --delta
+		bool bCached = false;
+		sCacheKey cacheKey;
+		if(!cache.strDir.empty()) {
+			bCached = !lookupCachedMst(strFileName,options,cache,&cacheKey,&result);
+			if(cacheKey.strName.empty())
+				return EXIT_FAILURE;
+			if(bCached && !bVerify && vDeltaFiles.empty())
+				return reportMst(EXIT_SUCCESS,result,outputConfig,NULL,options.bForest);
+		}
+		// Populates data from file and generates a CSR graph
+		if(!populateDataFromFile(&strFileName,&graph,numOfThreads)) {
 #ifdef LOG_ON
-				printGraph(vertices,numOfNodes);
+				printGraph(&graph);
 #endif
-			if (bSimpleScheme) {
-				// If -s option was given use simple scheme
-				return generateMSTSimpleScheme(vertices,numOfNodes);
-			}
-			else {
-				// If -f option was given use f-heap scheme
-				return generateMSTFibonacciScheme(vertices,numOfNodes);
-			}
+			// -s simple scheme, -f f-heap or the heap given by --heap, -k Kruskal
+			// (filter-Kruskal with --filter), -b parallel Boruvka, -d Prim over a
+			// cost matrix
+			const bool bFailed = bCached ? EXIT_SUCCESS : solveMst(&graph,options,NULL,&result);
+			if(!bFailed && !bCached && !cacheKey.strName.empty())
+				storeCache(cache,cacheKey,graph.numOfNodes,result);
+			if(vDeltaFiles.empty())
+				return reportMst(bFailed,result,outputConfig,verifyGraph,options.bForest);
+			// Dynamic mode
+			// Computes the tree once and updates it with every delta file in turn
+			if(!reportMst(bFailed,result,outputConfig,verifyGraph,options.bForest))
+				return applyDeltaFiles(&graph,result,vDeltaFiles,outputConfig);
 		}
 	}
 	else {
 		// Random mode
-		// Generates a random graph and checks for connectivity using DFS
-		if(!generateRandomGraph(vertices,numOfNodes,density)) {
+		// Generates a connected random graph from the seed
+		if(!bSeedGiven)
+			seed = time(NULL);
+		cout << "--> Generating graph with " << numOfNodes << " vertices, density " << density
+			 << "%, seed " << seed << " ..." << endl;
+		string strError;
+		if(generateRandomGraph(&graph,numOfNodes,density,seed,numOfThreads,strError))
+			cout << "  Error: " << strError << endl;
+		else {
+			cout << "--> Graph generated with " << graph.numOfEdges << " edges ..." << endl;
 
 #ifdef LOG_ON
-			printGraph(vertices,numOfNodes);
+			printGraph(&graph);
 #endif
 			/*
 			 * In random mode, first generate MST using simple scheme and then generate
 			 * using f-heap scheme. Both the functions will print time taken during
 			 * the execution
 			 */
+			sWorkspace workspace;
 			cout << "==============================" << endl;
 			cout << "Simple Scheme:" << endl;
-			if(!generateMSTSimpleScheme(vertices,numOfNodes)) {
-				cout << "Fibonacci Scheme:" <<endl;
-				resetVisited(vertices,numOfNodes);
-				return generateMSTFibonacciScheme(vertices,numOfNodes);
+			options.scheme = SIMPLE_SCHEME;
+			if(!reportMst(solveMst(&graph,options,&workspace,&result),result,outputConfig,verifyGraph,options.bForest)) {
+				if (options.strHeapName == "fheap")
+					cout << "Fibonacci Scheme:" <<endl;
+				else
+					cout << "Heap Scheme (" << options.strHeapName << "):" << endl;
+				options.scheme = HEAP_SCHEME;
+				return reportMst(solveMst(&graph,options,&workspace,&result),result,outputConfig,verifyGraph,options.bForest);
 			}
 		}
 	}
@@ -99,282 +314,257 @@ int main(int argc, char **argv) {
 void printHelp() {
 	cout << "mst -s file-name" << endl;
 	cout << "mst -f file-name" << endl;
-	cout << "mst -r n d \t n = number of nodes, d = density" << endl;
+	cout << "mst -k file-name [--filter] \t Kruskal, --filter uses filter-Kruskal" << endl;
+	cout << "mst -b file-name [-t threads] \t parallel Boruvka, one thread per core by default" << endl;
+	cout << "mst -d file-name [-t threads] \t Prim over an n x n cost matrix with vector sweeps, for dense graphs" << endl;
+	cout << "mst --convert text-file binary-file \t write a graph as a memory mappable binary file," << endl;
+	cout << "           \t which -s, -f, -k, -b and -d accept in place of a text file" << endl;
+	cout << "mst --compress graph-file compressed-file \t write a graph with delta and varint coded" << endl;
+	cout << "           \t neighbours and bit packed costs, read by every mode that takes a graph file" << endl;
+	cout << "mst -r n d [--seed s] [-t threads] \t n = number of nodes, d = density in percent" << endl;
+	cout << "           \t (fractional for sparse graphs), the same seed gives the same graph" << endl;
+	cout << "mst --batch manifest [-t threads] [-o results] \t run every job of the manifest, one" << endl;
+	cout << "           \t \"-f file [--heap h]\" style line per job, on a thread pool and write" << endl;
+	cout << "           \t one CSV line per job to the results (standard output by default)" << endl;
+	cout << "mst -f file-name --delta file [--delta file ...] \t compute the MST once, then" << endl;
+	cout << "           \t apply every delta file (\"+ u v cost\", \"- u v\" or \"= u v cost\" lines)" << endl;
+	cout << "           \t as one batch and print the tree edges that changed, works with -s, -k, -b, -d too" << endl;
+	cout << "mst --external file-name [--memory mb] [--temp dir] [--forest] \t Kruskal for text, binary or compressed graph" << endl;
+	cout << "           \t files larger than memory: sorted runs of the edges go to dir ($TMPDIR or /tmp by default)" << endl;
+	cout << "           \t and are merged within a budget of mb megabytes (default 1024), the" << endl;
+	cout << "           \t union-find takes 5 bytes per vertex of it. Reports the bytes read and written." << endl;
+	cout << "           \t A disconnected graph fails unless --forest asks for its spanning forest" << endl;
+	cout << "mst --verify-tree graph-file tree-file [--forest] \t check that a tree written by --output text" << endl;
+	cout << "           \t (\"start end [cost]\" lines) or binary is a minimum spanning tree, or with --forest" << endl;
+	cout << "           \t a minimum spanning forest, of the graph" << endl;
+	cout << "  --verify \t check the tree of any scheme: it spans the graph and no graph edge is" << endl;
+	cout << "           \t cheaper than the heaviest tree edge on its tree path (offline LCA, near linear time)" << endl;
+	cout << "  --cache dir \t keep the trees of -s, -f, -k, -b and -d in dir, keyed by a hash of the" << endl;
+	cout << "           \t graph file's content and the options: a repeated request skips loading and" << endl;
+	cout << "           \t solving. Safe to share between mst processes" << endl;
+	cout << "  --cache-size mb \t size bound of the cache directory (default 1024), the least" << endl;
+	cout << "           \t recently used trees are dropped beyond it" << endl;
+	cout << "  --forest \t minimum spanning forest for graphs that aren't connected: every" << endl;
+	cout << "           \t component is solved on its own, side by side on -t threads, and the" << endl;
+	cout << "           \t text output gives the root, size and TotalCost of every tree" << endl;
+	cout << "  --reorder r \t renumber the vertices for locality before the scheme runs: bfs, rcm" << endl;
+	cout << "           \t (reverse Cuthill-McKee), degree (decreasing) or none (default). The tree" << endl;
+	cout << "           \t keeps the original ids, the reordering is timed on its own" << endl;
+	cout << "  --output m \t how the MST is reported: text (default), binary (edge triples," << endl;
+	cout << "           \t needs -o) or summary (TotalCost, edge count and timings only)" << endl;
+	cout << "  -o file  \t write the MST edges to file instead of the standard output" << endl;
+	cout << "  --insert m \t when -f and -r put vertices into the heap: lazy (default, when first" << endl;
+	cout << "           \t reached) or eager (all of them up front)" << endl;
+	cout << "  --heap h \t priority queue used by -f and -r:" << endl;
+	cout << "           \t fheap (default), binary, 4ary, pairing, lazy, bucket (integer costs only)" << endl;
+	cout << "  --bucket-limit n \t largest cost the bucket heap takes (default 65535, at most" << endl;
+	cout << "           \t 262143), a graph with a cost outside [0, n] runs on the binary heap" << endl;
 }
 
 /*
  * Print graph function for debugging purpose
  */
-void printGraph(sVertex* vertices, const uint numOfNodes) {
-	for(uint i=0;i<numOfNodes;i++) {
-		for (list<sEdge>::iterator it = vertices[i].adj.begin(); it != vertices[i].adj.end(); it++) {
-			cout << "\t" << i << "->"<< it->vertexEnd << "  " << it->cost << endl;
+void printGraph(const sGraph* graph) {
+	for(uint i=0;i<graph->numOfNodes;i++) {
+		for (uint64_t e = graph->offsets[i]; e < graph->offsets[i+1]; e++) {
+			cout << "\t" << i << "->"<< graph->adjVertex[e] << "  " << graph->cost(e) << endl;
 		}
 		cout << "-------------------------" << endl;
 	}
 }
 
 /*
- * Reset all visited states to false
+ * Populates graph from the given file. Text files are parsed in parallel by
+ * loadTextGraph, binary graph files (see GraphFile.h) are memory mapped and
+ * compressed graph files (see CompressedGraph.h) are decoded into CSR form.
  */
-void resetVisited(sVertex* vertices, const uint numOfNodes) {
-	for(uint i=0;i<numOfNodes;i++) {
-		vertices[i].visited = false;
-		for (list<sEdge>::iterator it = vertices[i].adj.begin(); it != vertices[i].adj.end(); it++) {
-			it->visited = false;
-		}
+bool populateDataFromFile(const string* fileName,sGraph* graph,uint numOfThreads) {
+	struct timeval start, end;
+	gettimeofday(&start, NULL);
+	if(isGraphFile(*fileName)) {
+		// Binary graph files are mapped as they are, no parsing needed
+		if(mapGraphFile(*fileName,graph,cout))
+			return EXIT_FAILURE;
+	}
+	else if(isCompressedGraphFile(*fileName)) {
+		if(loadCompressedGraph(*fileName,graph,cout))
+			return EXIT_FAILURE;
 	}
+	else if(loadTextGraph(*fileName,graph,numOfThreads,cout)) {
+		return EXIT_FAILURE;
+	}
+	gettimeofday(&end, NULL);
+	cout << "Load Time = " << (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec)
+		 << " microseconds" << endl;
+	return EXIT_SUCCESS;
 }
 
 /*
- * Populates graph from the given file. It reads from the file line by line.
+ * Looks the tree of the file up in the result cache (see ResultCache.h)
+ * and prints whether it was there. Hashing the file counts as part of the
+ * lookup, on a hit that is the result's mtime. Returns EXIT_SUCCESS on a
+ * hit, the key has no name if the file couldn't be read.
  */
-bool populateDataFromFile(const string* fileName,sVertex* vertices) {
-	ifstream file(fileName->c_str());
-	string line,item;
-	stringstream lineSS,itemSS;
-	uint v1=0,v2=0;
-	int cost=0;
-	sEdge e1;
-
-	if(file.good()) {
-		getline(file,line);
-		lineSS.str(line);
-
-		// Get number of nodes
-		getline(lineSS, item, ' ');
-		itemSS.str(item);
-		itemSS >> numOfNodes;
-		itemSS.clear();
-
-		// Get number of edges
-		getline(lineSS, item, ' ');
-		itemSS.str(item);
-		itemSS >> numOfEdges;
-		itemSS.clear();
-
-		while (getline(file,line)) {
-			// Process line
-			lineSS.clear();
-#ifdef LOG_ON
-			cout << line << endl;
-#endif
-			// Get vertex start
-			lineSS.str(line);
-			getline(lineSS, item, ' ');
-			itemSS.str(item);
-			itemSS >> v1;
-			itemSS.clear();
-
-			// Get vertex end
-			getline(lineSS, item, ' ');
-			itemSS.str(item);
-			itemSS >> v2;
-			itemSS.clear();
+bool lookupCachedMst(const string& strFileName, const sMstOptions& options, const sResultCache& cache,
+		sCacheKey* key, sMstResult* result) {
+	struct timeval start, end;
+	gettimeofday(&start, NULL);
+	if(makeCacheKey(strFileName,options,key)) {
+		key->strName.clear();
+		return EXIT_FAILURE;
+	}
+	const bool bMissed = lookupCache(cache,*key,result);
+	gettimeofday(&end, NULL);
+	const long ltime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+	cout << "Cache = " << (bMissed ? "miss" : "hit") << ", Lookup Time = " << ltime << " microseconds" << endl;
+	if(!bMissed)
+		result->mtime = ltime;
+	return bMissed;
+}
 
-			// Get vertex cost
-			getline(lineSS, item, ' ');
-			itemSS.str(item);
-			itemSS >> cost;
-			itemSS.clear();
+/*
+ * Prints the tree a scheme found in the selected output mode, or why it
+ * failed, and passes the status on. A verifyGraph checks the tree against
+ * it as well, a tree that isn't minimum fails the run, and so does a forest
+ * unless bForest asked for one.
+ */
+bool reportMst(bool bFailed, const sMstResult& result, const sOutputConfig& outputConfig, const sGraph* verifyGraph,
+		bool bForest) {
+	if(bFailed) {
+		cout << result.strError << endl;
+		return EXIT_FAILURE;
+	}
+	bFailed = writeMstOutput(outputConfig,result);
+	cout << result.strDetails;
+	if(verifyGraph && reportVerify(verifyGraph,result,bForest))
+		bFailed = true;
+	cout << "==============================" << endl;
+	return bFailed;
+}
 
-#ifdef LOG_ON
-			cout << "read:" << v1 << "," << v2 << "," << cost << endl;
-#endif
+/*
+ * Checks a tree with the verifier of Verifier.h and prints the outcome
+ */
+bool reportVerify(const sGraph* graph, const sMstResult& result, bool bForest) {
+	sVerifyResult verify;
+	const bool bFailed = verifyMst(graph,result,bForest,&verify);
+	if(bFailed)
+		cout << "Verified = no, " << verify.strError << endl;
+	else
+		cout << "Verified = yes, Trees = " << verify.numOfTrees << ", Edges Checked = " << verify.numOfChecked << endl;
+	cout << "Verify Time = " << verify.vtime << " microseconds" << endl;
+	return bFailed;
+}
 
-			//Add this edge to graph
-			e1.vertexStart = v1;
-			e1.vertexEnd = v2;
-			e1.cost = cost;
-			e1.visited = false;
-			vertices[v1].id = v1;
-			vertices[v1].visited = false;
-			vertices[v1].adj.push_back(e1);
+/*
+ * Verify mode. Reads a tree written in the text or binary output mode and
+ * checks it against the graph. Text trees without costs take them from the
+ * graph, a binary tree's TotalCost has to match its edges too. Only with
+ * bForest (--forest) may the tree be a forest of a disconnected graph.
+ */
+bool verifyTreeFile(const sGraph* graph, const string& strTreeFile, bool bForest) {
+	sMstResult result;
+	bool bCosts;
 
-			// Since graph is undirected, add an edge from v2 to v1 also
-			e1.vertexStart = v2;
-			e1.vertexEnd = v1;
-			e1.cost = cost;
-			e1.visited = false;
-			vertices[v2].id = v2;
-			vertices[v2].visited = false;
-			vertices[v2].adj.push_back(e1);
-		}
-		itemSS.flush();
-		lineSS.flush();
-		file.close();
-		return EXIT_SUCCESS;
-	}
-	else {
-		cout << "Unable to open file \"" << fileName <<"\"" << endl;
+	if(readMstOutput(strTreeFile,&result,&bCosts))
 		return EXIT_FAILURE;
+	if(!bCosts) {
+		lookupTreeCosts(graph,result.vEdges);
+		result.totalCost = 0;
+		for(size_t i = 0; i < result.vEdges.size(); i++)
+			result.totalCost += result.vEdges[i].cost;
 	}
+	cout << "TotalCost = " << result.totalCost << endl;
+	cout << "Edges = " << result.vEdges.size() << endl;
+	const bool bFailed = reportVerify(graph,result,bForest);
+	cout << "==============================" << endl;
+	return bFailed;
 }
 
-/* Algorithm :
-		1.	Maintain an array on the vertices V (G).
-		2. 	Put s in the queue, where s is the start vertex. Give s a key of 0.
-			Add all other vertices and set their key to infinity.
-		3. 	Repeatedly get the minimum-key vertex v from the array and mark it scanned.
-			For each neighbor w of v do:
-				If w is not scanned (so far), decrease its key to the min[cost(v,w) , w’s currentkey]
-*/
-bool generateMSTSimpleScheme(sVertex* vertices, const uint numOfNodes) {
+/*
+ * Dynamic mode. Applies every delta file to the tree of the graph as one
+ * batch and prints the new TotalCost and the tree edges that changed:
+ * "+ u v cost" joined the tree, "- u v cost" left it, "= u v cost" stayed
+ * with a new cost. Summary output mode leaves out the edges.
+ */
+bool applyDeltaFiles(const sGraph* graph, const sMstResult& result, const vector<string>& vDeltaFiles,
+		const sOutputConfig& outputConfig) {
+	sDynamicMst mst;
+	sDeltaResult delta;
+	vector<sDeltaOp> vOps;
 	struct timeval start, end;
-	long mtime, seconds, useconds;
-	// the final MST will be stored in vMstOutput
-	vector<sEdge> vMstOutput(numOfNodes);
-	uint curMstIdx = 0;
-	// Array to hold costs. Initially every vertex has infinity cost
-	int curMstNodes[numOfNodes];
-	// For recording parent from where the node can be accessed with the least cost
-	uint vParentIds[numOfNodes];
-
-	uint extractedVertexIdx = 0, totalCost = 0;
-	int currentCost = MAX_COST, extractedCost = MAX_COST;
 
-
-	// Adding root to the spanning tree initially and setting other node cost to infinity
-	curMstNodes[0]= 0;
-	vertices[0].visited = false;
-	for(uint i=1; i < numOfNodes ;i++) {
-		vertices[i].visited = false;
-		curMstNodes[i] = MAX_COST;
-	}
-
-	// Start recording the time
 	gettimeofday(&start, NULL);
-
-	while(curMstIdx < numOfNodes) {
-
-		extractedCost = MAX_COST;
-
-		//Find the min element
-		for(uint i=0; i < numOfNodes; i++) {
-			if(curMstNodes[i] < extractedCost && !vertices[i].visited) {
-				extractedCost = curMstNodes[i];
-				extractedVertexIdx = i;
-			}
+	buildDynamicMst(graph,result,&mst);
+	gettimeofday(&end, NULL);
+	cout << "Build Time = " << (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec)
+		 << " microseconds" << endl;
+
+	for(size_t i = 0; i < vDeltaFiles.size(); i++) {
+		if(readDeltaFile(vDeltaFiles[i],graph->numOfNodes,vOps))
+			return EXIT_FAILURE;
+		const bool bFailed = applyDelta(&mst,vOps,&delta);
+		cout << "Delta = " << vDeltaFiles[i] << ", Inserts = " << delta.inserts << ", Deletes = " << delta.deletes
+			 << ", Changes = " << delta.changes << endl;
+		cout << "TotalCost = " << delta.totalCost << endl;
+		if(outputConfig.mode != OUTPUT_SUMMARY) {
+			const char* tags[] = { "+ ", "- ", "= " };
+			const vector<sEdge>* lists[] = { &delta.vAdded, &delta.vRemoved, &delta.vChanged };
+			for(uint l = 0; l < 3; l++)
+				for(size_t e = 0; e < lists[l]->size(); e++)
+					cout << tags[l] << (*lists[l])[e].vertexStart << " " << (*lists[l])[e].vertexEnd
+						 << " " << (*lists[l])[e].cost << "\n";
 		}
-		vertices[extractedVertexIdx].visited = true;
-#ifdef LOG_ON
-		cout << "nextMin = " << extractedVertexIdx << " cost = " << extractedCost << endl;
-#endif
-
-		vMstOutput[curMstIdx].vertexStart = vParentIds[extractedVertexIdx];
-		vMstOutput[curMstIdx].vertexEnd = extractedVertexIdx;
-		vMstOutput[curMstIdx].cost = extractedCost;
-		totalCost +=  extractedCost;
-
-		// Iterate through all the edges of the vertex and set the cost if cost < currentCost
-		list<sEdge>::iterator it = vertices[extractedVertexIdx].adj.begin();
-		for (; it != vertices[extractedVertexIdx].adj.end(); it++) {
-#ifdef LOG_ON
-			cout << vertices[extractedVertexIdx] << "->" << *it << endl;
-#endif
-			if(!vertices[it->vertexEnd].visited) {
-				currentCost = curMstNodes[it->vertexEnd];
-				if(it->cost < currentCost) {
-					curMstNodes[it->vertexEnd] = it->cost;
-					vParentIds[it->vertexEnd] = extractedVertexIdx;
-				}
-			}
+		cout << "Tree Changes = " << delta.vAdded.size() + delta.vRemoved.size() + delta.vChanged.size() << endl;
+		if(delta.numOfComponents > 1)
+			cout << "Graph is not connected, the tree is a forest of " << delta.numOfComponents << " trees" << endl;
+		cout << "Update Time = " << delta.mtime << " microseconds" << endl;
+		if(bFailed) {
+			cout << delta.strError << endl;
+			return EXIT_FAILURE;
 		}
-#ifdef LOG_ON
-		cout << endl;
-#endif
-		curMstIdx++;
+		cout << "==============================" << endl;
 	}
-	gettimeofday(&end, NULL);
-	seconds  = end.tv_sec  - start.tv_sec;
-	useconds = end.tv_usec - start.tv_usec;
-	mtime = ((seconds) * 1000000 + useconds) ;
-
-	// Output the total cost
-	cout << "TotalCost = " << totalCost << endl;
-	// Output MST with n-1 items
-	for (uint i=1; i < numOfNodes;i++)
-		cout << setw(6) << left << vMstOutput[i].vertexStart
-			 << setw(6) << left << vMstOutput[i].vertexEnd << endl;
-	cout << "Time Taken = " << mtime << " microseconds"<< endl;
-	cout << "==============================" << endl;
-
 	return EXIT_SUCCESS;
 }
 
-/* Algorithm :
-		1.	Maintain a priority queue on the vertices V (G).
-		2. 	Put s in the queue, where s is the start vertex. Give s a key of 0.
-			Add all other vertices and set their key to infinity.
-		3. 	Repeatedly delete the minimum-key vertex v from the queue and mark it scanned.
-			For each neighbor w of v do:
-				If w is not scanned (so far), decrease its key to the min[cost(v,w) , w’s currentkey]
-*/
-bool generateMSTFibonacciScheme(sVertex* vertices, const uint numOfNodes) {
-	// the final MST will be stored in vMstOutput
-	vector<sEdge> vMstOutput(numOfNodes);
-	uint totalCost = 0,curMstIdx = 0, extractedVertexIdx;
-	// For recording parent from where the node can be accessed with the least cost
-	uint vParentIds[numOfNodes];
- 	int currentCost = 0;
-
-
-	FHeap vertexHeap;
-	//Saving pointer to fHeapNode (returned by insert) in fNodes vector for decreaseKey operation
-	vector<FHeapNode*> fNodes(numOfNodes);
+/*
+ * External mode. Runs the semi-external Kruskal scheme over the edge file,
+ * writes the tree in the output mode as it's found and reports how much was
+ * read and written, which is what --memory trades against.
+ */
+bool runExternalMst(const string& strFileName, const sExternalOptions& options, const sOutputConfig& outputConfig) {
+	sEdgeStream stream;
+	sExternalResult result;
 
-	// Setting root node's key to 0 and others to infinity
-	fNodes[0] = vertexHeap.insert(0,0);
-	for(uint i=1; i < numOfNodes ;i++) {
-		vertices[i].visited = false;
-		fNodes[i] = vertexHeap.insert(i,MAX_COST);
+	if(openEdgeStream(outputConfig,&stream))
+		return EXIT_FAILURE;
+	bool bFailed = generateExternalMst(strFileName,options,&stream,&result);
+	if(closeEdgeStream(outputConfig,&stream))
+		bFailed = true;
+	if(bFailed) {
+		if(!result.strError.empty())
+			cout << result.strError << endl;
+		return EXIT_FAILURE;
 	}
-
-	struct timeval start, end;
-	long mtime, seconds, useconds;
-	gettimeofday(&start, NULL);
-
-	while(curMstIdx < numOfNodes) {
-
-		//Find the min element by using removeMin
-		FHeapNode temp = *vertexHeap.minimum();
-		vertexHeap.removeMinimum();
-		extractedVertexIdx = temp.data();
-		vertices[extractedVertexIdx].visited  = true;
-
-		//Store in MST for later use
-		vMstOutput[curMstIdx].vertexStart = vParentIds[vertices[extractedVertexIdx].id];
-		vMstOutput[curMstIdx].vertexEnd = extractedVertexIdx;
-		vMstOutput[curMstIdx].cost = temp.key();
-		totalCost +=  temp.key();
-
-		// Iterate through all the edges of the vertex and do the decreaseKey if cost < currentCost
-		list<sEdge>::iterator it = vertices[extractedVertexIdx].adj.begin();
-		for(;it != vertices[extractedVertexIdx].adj.end();it++) {
-			if(!vertices[it->vertexEnd].visited) {
-				currentCost = fNodes[it->vertexEnd]->key();
-				if(it->cost < currentCost) {
-					vertexHeap.decreaseKey(fNodes[it->vertexEnd],it->cost);
-					vParentIds[it->vertexEnd] = vertices[extractedVertexIdx].id;
-				}
-			}
-		}
-		curMstIdx++;
+	cout << "Vertices = " << result.numOfNodes << ", Edge Lines = " << result.numOfInputEdges
+		 << ", Self Loops = " << result.numOfSelfLoops << endl;
+	cout << "TotalCost = " << result.totalCost << endl;
+	cout << "Edges = " << result.numOfEdges << endl;
+	// The edges are out by now, but like every scheme the run fails without --forest
+	if(result.numOfEdges + 1 < result.numOfNodes && !options.bForest) {
+		cout << "Graph is not connected, it has no spanning tree" << endl;
+		bFailed = true;
 	}
-	gettimeofday(&end, NULL);
-	seconds  = end.tv_sec  - start.tv_sec;
-	useconds = end.tv_usec - start.tv_usec;
-	mtime = ((seconds) * 1000000 + useconds) ;
-
-	// Total cost
-	cout << "TotalCost = " << totalCost << endl;
-	// Output MST with n-1 items
-	for (uint i=1; i < numOfNodes;i++)
-			cout << setw(6) << left << vMstOutput[i].vertexStart
-				 << setw(6) << left << vMstOutput[i].vertexEnd << endl;
-	cout << "Time Taken = " << mtime << " microseconds"<< endl;
+	else if(result.numOfEdges + 1 < result.numOfNodes)
+		cout << "Graph is not connected, the tree is a forest of " << result.numOfNodes - result.numOfEdges
+			 << " trees" << endl;
+	cout << "Memory = " << (options.memoryBudget >> 20) << " MB, Run Edges = " << result.runEdges << ", Runs = "
+		 << result.numOfRuns << ", Merge Passes = " << result.numOfMergePasses << endl;
+	cout << "Input Read = " << result.inputBytes << " bytes, Runs Written = " << result.runBytesWritten
+		 << " bytes, Runs Read = " << result.runBytesRead << " bytes" << endl;
+	cout << "Run Time = " << result.runTime << " microseconds" << endl;
+	cout << "Time Taken = " << result.mtime << " microseconds" << endl;
 	cout << "==============================" << endl;
-
-	return EXIT_SUCCESS;
+	return bFailed;
 }
-
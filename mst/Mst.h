@@ -17,18 +17,31 @@
 #include <string>
 #include <list>
 #include "Global.h"
+#include "Graph.h"
+#include "GraphFile.h"
+#include "CompressedGraph.h"
+#include "GraphLoader.h"
+#include "MstOutput.h"
 #include "RandomGraph.h"
-#include "FibonacciHeap.hpp"
-
-static sVertex vertices[MAX_NODES];
-static bool bUserInputMode = false,bSimpleScheme = false;
-static int numOfNodes = 0, density = 0, numOfEdges = 0;
+#include "MstSolver.h"
+#include "Batch.h"
+#include "DynamicMst.h"
+#include "ExternalMst.h"
+#include "Parallel.h"
+#include "Verifier.h"
+#include "ResultCache.h"
 
 void printHelp();
-void printGraph(sVertex* vertices, const uint numOfNodes);
-void resetVisited(sVertex* vertices, const uint numOfNodes);
-bool populateDataFromFile(const string* fileName,sVertex* vertices);
-bool generateMSTSimpleScheme(sVertex* vertices, const uint numOfNodes);
-bool generateMSTFibonacciScheme(sVertex* vertices, const uint numOfNodes);
+void printGraph(const sGraph* graph);
+bool populateDataFromFile(const string* fileName,sGraph* graph,uint numOfThreads);
+bool lookupCachedMst(const string& strFileName, const sMstOptions& options, const sResultCache& cache,
+		sCacheKey* key, sMstResult* result);
+bool reportMst(bool bFailed, const sMstResult& result, const sOutputConfig& outputConfig, const sGraph* verifyGraph,
+		bool bForest);
+bool reportVerify(const sGraph* graph, const sMstResult& result, bool bForest);
+bool verifyTreeFile(const sGraph* graph, const string& strTreeFile, bool bForest);
+bool applyDeltaFiles(const sGraph* graph, const sMstResult& result, const vector<string>& vDeltaFiles,
+		const sOutputConfig& outputConfig);
+bool runExternalMst(const string& strFileName, const sExternalOptions& options, const sOutputConfig& outputConfig);
 
 #endif /* MST_H_ */
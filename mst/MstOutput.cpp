@@ -0,0 +1,317 @@
+/*
+ * MstOutput.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <iostream>
+#include <fstream>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <sys/time.h>
+#include "MstOutput.h"
+
+/*
+ * Selects the output mode by name (text, binary or summary) and the file
+ * the edges are written to. Empty file name means standard output.
+ */
+bool setOutputMode(const string& modeName, const string& fileName, sOutputConfig* config) {
+	if (modeName == "text")
+		config->mode = OUTPUT_TEXT;
+	else if (modeName == "binary")
+		config->mode = OUTPUT_BINARY;
+	else if (modeName == "summary")
+		config->mode = OUTPUT_SUMMARY;
+	else {
+		cout << "Unknown output mode \"" << modeName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	if (config->mode == OUTPUT_BINARY && fileName.empty()) {
+		cout << "Binary output needs a file, give one with -o" << endl;
+		return EXIT_FAILURE;
+	}
+	config->strFile = fileName;
+	return EXIT_SUCCESS;
+}
+
+// Appends value left aligned in a field of width 6, like setw(6) << left,
+// with at least one space after it so longer ids stay apart
+static inline char* appendField(char* p, int value) {
+	char* end = to_chars(p, p + 16, value).ptr;
+	do
+		*end++ = ' ';
+	while (end < p + 6);
+	return end;
+}
+
+// Appends text followed by value
+static inline char* appendValue(char* p, const char* text, int64_t value) {
+	const size_t length = strlen(text);
+	memcpy(p, text, length);
+	return to_chars(p + length, p + length + 24, value).ptr;
+}
+
+/*
+ * Formats the edges as "start end" lines into large blocks, so the stream
+ * is written once per block instead of flushed once per edge. A forest gets
+ * a "Component = ..." line ahead of the edges of every tree.
+ */
+static void writeTextEdges(ostream& out, const sMstResult& result) {
+	const sEdge* vEdges = result.vEdges.data();
+	const uint64_t numOfEdges = result.vEdges.size();
+	const uint64_t numOfComponents = result.vComponents.size();
+	// Room for the longest line, the component line
+	const size_t maxLine = 128;
+	vector<char> buffer(min<uint64_t>(MST_OUTPUT_BLOCK_SIZE, (numOfEdges + numOfComponents + 1) * maxLine));
+	char* p = &buffer[0];
+	char* const limit = &buffer[0] + buffer.size() - maxLine;
+	uint64_t component = 0;
+
+	for (uint64_t i = 0; i < numOfEdges || component < numOfComponents; ) {
+		if (component < numOfComponents && result.vComponents[component].firstEdge == i) {
+			const sMstComponent& tree = result.vComponents[component];
+			p = appendValue(p, "Component = ", component++);
+			p = appendValue(p, ", Root = ", tree.root);
+			p = appendValue(p, ", Vertices = ", tree.numOfNodes);
+			p = appendValue(p, ", TotalCost = ", tree.totalCost);
+		} else {
+			p = appendField(p, vEdges[i].vertexStart);
+			p = appendField(p, vEdges[i].vertexEnd);
+			i++;
+		}
+		*p++ = '\n';
+		if (p >= limit) {
+			out.write(&buffer[0], p - &buffer[0]);
+			p = &buffer[0];
+		}
+	}
+	out.write(&buffer[0], p - &buffer[0]);
+	out.flush();
+}
+
+static void writeBinaryHeader(ostream& out, uint64_t numOfEdges, int64_t totalCost) {
+	sMstOutputHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MST_OUTPUT_MAGIC, sizeof(header.magic));
+	header.version = MST_OUTPUT_VERSION;
+	header.numOfEdges = numOfEdges;
+	header.totalCost = totalCost;
+	out.write((const char*)&header, sizeof(header));
+}
+
+static bool writeBinaryEdges(const string& strOutputFile, const sEdge* vEdges, uint64_t numOfEdges, int64_t totalCost) {
+
+	ofstream file(strOutputFile.c_str(), ios::binary | ios::trunc);
+	if (!file.good()) {
+		cout << "Unable to open file \"" << strOutputFile << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	writeBinaryHeader(file, numOfEdges, totalCost);
+	vector<sMstOutputEdge> block;
+	const uint64_t blockEdges = MST_OUTPUT_BLOCK_SIZE / sizeof(sMstOutputEdge);
+	for (uint64_t first = 0; first < numOfEdges; first += blockEdges) {
+		const uint64_t last = min(first + blockEdges, numOfEdges);
+		block.resize(last - first);
+		for (uint64_t i = first; i < last; i++) {
+			block[i-first].vertexStart = vEdges[i].vertexStart;
+			block[i-first].vertexEnd = vEdges[i].vertexEnd;
+			block[i-first].cost = vEdges[i].cost;
+		}
+		file.write((const char*)&block[0], block.size() * sizeof(sMstOutputEdge));
+	}
+	file.close();
+	if (file.fail()) {
+		cout << "Unable to write file \"" << strOutputFile << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Reports the MST found by a scheme in the selected output mode, followed
+ * by the time the scheme took. Writing the edges is timed on its own.
+ */
+bool writeMstOutput(const sOutputConfig& config, const sMstResult& result) {
+	struct timeval start, end;
+	bool bFailed = false;
+	const sEdge* vEdges = result.vEdges.data();
+	const uint64_t numOfEdges = result.vEdges.size();
+	const int64_t totalCost = result.totalCost;
+	const string& strOutputFile = config.strFile;
+
+	// Output the total cost
+	cout << "TotalCost = " << totalCost << endl;
+
+	gettimeofday(&start, NULL);
+	if (config.mode == OUTPUT_TEXT) {
+		if (strOutputFile.empty()) {
+			writeTextEdges(cout, result);
+		} else {
+			ofstream file(strOutputFile.c_str(), ios::trunc);
+			writeTextEdges(file, result);
+			file.close();
+			if (file.fail()) {
+				cout << "Unable to write file \"" << strOutputFile << "\"" << endl;
+				bFailed = true;
+			}
+		}
+	}
+	else if (config.mode == OUTPUT_BINARY) {
+		bFailed = writeBinaryEdges(strOutputFile, vEdges, numOfEdges, totalCost);
+	}
+	gettimeofday(&end, NULL);
+	const long otime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+
+	if (config.mode != OUTPUT_TEXT || !strOutputFile.empty())
+		cout << "Edges = " << numOfEdges << endl;
+	cout << "Time Taken = " << result.mtime << " microseconds"<< endl;
+	if (config.mode != OUTPUT_SUMMARY)
+		cout << "Output Time = " << otime << " microseconds" << endl;
+	return bFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*
+ * Opens the output of a streamed tree: the -o file, or the standard output
+ * for text without one. A binary file starts with a blank header until
+ * closeEdgeStream knows the counts. Summary mode writes nothing.
+ */
+bool openEdgeStream(const sOutputConfig& config, sEdgeStream* stream) {
+	stream->mode = config.mode;
+	stream->numOfEdges = 0;
+	stream->totalCost = 0;
+	if (config.mode == OUTPUT_SUMMARY)
+		return EXIT_SUCCESS;
+	if (config.mode == OUTPUT_TEXT && config.strFile.empty()) {
+		stream->out = &cout;
+		return EXIT_SUCCESS;
+	}
+	stream->file.open(config.strFile.c_str(), config.mode == OUTPUT_BINARY ? ios::binary | ios::trunc : ios::trunc);
+	if (!stream->file.good()) {
+		cout << "Unable to open file \"" << config.strFile << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	stream->out = &stream->file;
+	if (config.mode == OUTPUT_BINARY)
+		writeBinaryHeader(stream->file, 0, 0);
+	return EXIT_SUCCESS;
+}
+
+void sEdgeStream::write(const sEdge* vEdges, size_t count) {
+	numOfEdges += count;
+	for (size_t i = 0; i < count; i++)
+		totalCost += vEdges[i].cost;
+	if (mode == OUTPUT_TEXT) {
+		// Two fields of at most 11 characters and the line end
+		vBuffer.resize(count * 24);
+		char* p = &vBuffer[0];
+		for (size_t i = 0; i < count; i++) {
+			p = appendField(p, vEdges[i].vertexStart);
+			p = appendField(p, vEdges[i].vertexEnd);
+			*p++ = '\n';
+		}
+		out->write(&vBuffer[0], p - &vBuffer[0]);
+	}
+	else if (mode == OUTPUT_BINARY) {
+		vBuffer.resize(count * sizeof(sMstOutputEdge));
+		sMstOutputEdge* block = (sMstOutputEdge*)&vBuffer[0];
+		for (size_t i = 0; i < count; i++) {
+			block[i].vertexStart = vEdges[i].vertexStart;
+			block[i].vertexEnd = vEdges[i].vertexEnd;
+			block[i].cost = vEdges[i].cost;
+		}
+		out->write(&vBuffer[0], vBuffer.size());
+	}
+}
+
+// Fills in the binary header and closes the -o file
+bool closeEdgeStream(const sOutputConfig& config, sEdgeStream* stream) {
+	if (stream->out == &cout)
+		cout.flush();
+	if (!stream->file.is_open())
+		return EXIT_SUCCESS;
+	if (stream->mode == OUTPUT_BINARY) {
+		stream->file.seekp(0);
+		writeBinaryHeader(stream->file, stream->numOfEdges, stream->totalCost);
+	}
+	stream->file.close();
+	if (stream->file.fail()) {
+		cout << "Unable to write file \"" << config.strFile << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Reads a tree back from a binary output file or from text with one
+ * "start end" or "start end cost" line per edge, as the text output writes
+ * them. Lines that don't start with a number, like "Component = ..." lines,
+ * are skipped. Either every line gives a cost or none does, bCosts tells
+ * which. The TotalCost of a text file is the sum of the costs it gave.
+ */
+bool readMstOutput(const string& fileName, sMstResult* result, bool* bCosts) {
+	ifstream file(fileName.c_str(), ios::binary);
+	sMstOutputHeader header;
+
+	if (!file.good()) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	result->clear();
+	*bCosts = true;
+	if (file.read((char*)&header, sizeof(header)) && !memcmp(header.magic, MST_OUTPUT_MAGIC, sizeof(header.magic))) {
+		if (header.version != MST_OUTPUT_VERSION) {
+			cout << "File \"" << fileName << "\": unsupported output version " << header.version << endl;
+			return EXIT_FAILURE;
+		}
+		// The edge count is checked against the file before it sizes anything
+		const streampos edgesPos = file.tellg();
+		file.seekg(0, ios::end);
+		const uint64_t remaining = (uint64_t)(file.tellg() - edgesPos);
+		file.seekg(edgesPos);
+		if (header.numOfEdges > remaining / sizeof(sMstOutputEdge)) {
+			cout << "File \"" << fileName << "\": truncated, expected " << header.numOfEdges << " edges" << endl;
+			return EXIT_FAILURE;
+		}
+		vector<sMstOutputEdge> vOutput(header.numOfEdges);
+		if (!file.read((char*)vOutput.data(), vOutput.size() * sizeof(sMstOutputEdge))) {
+			cout << "Unable to read file \"" << fileName << "\"" << endl;
+			return EXIT_FAILURE;
+		}
+		result->vEdges.resize(vOutput.size());
+		for (size_t i = 0; i < vOutput.size(); i++) {
+			result->vEdges[i].vertexStart = vOutput[i].vertexStart;
+			result->vEdges[i].vertexEnd = vOutput[i].vertexEnd;
+			result->vEdges[i].cost = vOutput[i].cost;
+		}
+		result->totalCost = header.totalCost;
+		return EXIT_SUCCESS;
+	}
+
+	file.clear();
+	file.seekg(0);
+	string line;
+	uint lineNumber = 0;
+	while (getline(file, line)) {
+		lineNumber++;
+		const size_t first = line.find_first_not_of(" \t");
+		if (first == string::npos || !isdigit((unsigned char)line[first]))
+			continue;
+		istringstream words(line);
+		sEdge edge;
+		bool bValid = (bool)(words >> edge.vertexStart >> edge.vertexEnd);
+		const bool bCost = bValid && (words >> edge.cost);
+		if (result->vEdges.empty())
+			*bCosts = bCost;
+		if (!bValid || bCost != *bCosts) {
+			cout << "File \"" << fileName << "\": expected \"start end\" or \"start end cost\" on line "
+				 << lineNumber << ", the same on every line" << endl;
+			return EXIT_FAILURE;
+		}
+		if (!bCost)
+			edge.cost = 0;
+		result->totalCost += edge.cost;
+		result->vEdges.push_back(edge);
+	}
+	return EXIT_SUCCESS;
+}
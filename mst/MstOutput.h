@@ -0,0 +1,89 @@
+/*
+ * MstOutput.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef MSTOUTPUT_H_
+#define MSTOUTPUT_H_
+
+#include <string>
+#include <fstream>
+#include <stdint.h>
+#include "Global.h"
+#include "MstSolver.h"
+#include "ExternalMst.h"
+
+// How the schemes report the tree they found
+enum eOutputMode {
+	// TotalCost, one "start end" line per edge and the timings
+	OUTPUT_TEXT,
+	// TotalCost and the timings, the edges go to a binary file
+	OUTPUT_BINARY,
+	// TotalCost, the number of edges and the timings only
+	OUTPUT_SUMMARY
+};
+
+// Output mode and file given by --output and -o
+struct sOutputConfig {
+	eOutputMode mode;
+	// Empty means the standard output
+	string strFile;
+
+	sOutputConfig():
+		mode(OUTPUT_TEXT) {}
+};
+
+#define MST_OUTPUT_MAGIC "MSTOUT\r\n"
+#define MST_OUTPUT_VERSION 1
+// Text output is formatted into blocks of this size before it's written
+#define MST_OUTPUT_BLOCK_SIZE (1 << 20)
+
+/*
+ * Binary output layout (host byte order):
+ *
+ *   sMstOutputHeader
+ *   edges  sMstOutputEdge[numOfEdges]
+ */
+struct sMstOutputHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t numOfEdges;
+	int64_t totalCost;
+};
+
+struct sMstOutputEdge {
+	uint32_t vertexStart;
+	uint32_t vertexEnd;
+	int32_t cost;
+};
+
+/*
+ * Writes the tree in the output mode as a scheme finds it, for trees that
+ * are never held in memory as a whole. Text goes out in blocks of
+ * MST_OUTPUT_BLOCK_SIZE, the binary header is filled in by closeEdgeStream.
+ */
+struct sEdgeStream : public sEdgeSink {
+	eOutputMode mode;
+	ofstream file;
+	// The file, or the standard output for text without -o
+	ostream* out;
+	vector<char> vBuffer;
+	uint64_t numOfEdges;
+	int64_t totalCost;
+
+	sEdgeStream():
+		mode(OUTPUT_TEXT),out(NULL),numOfEdges(0),totalCost(0) {}
+
+	void write(const sEdge* vEdges, size_t count);
+};
+
+bool setOutputMode(const string& modeName, const string& fileName, sOutputConfig* config);
+bool writeMstOutput(const sOutputConfig& config, const sMstResult& result);
+bool openEdgeStream(const sOutputConfig& config, sEdgeStream* stream);
+bool closeEdgeStream(const sOutputConfig& config, sEdgeStream* stream);
+bool readMstOutput(const string& fileName, sMstResult* result, bool* bCosts);
+
+#endif /* MSTOUTPUT_H_ */
@@ -0,0 +1,453 @@
+/*
+ * MstSolver.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <iostream>
+#include <sstream>
+#include "MstSolver.h"
+#include "Kruskal.h"
+#include "Boruvka.h"
+#include "DensePrim.h"
+#include "SpanningForest.h"
+#include "Parallel.h"
+#include "FibonacciHeap.hpp"
+#include "FibonacciIndexHeap.hpp"
+#include "PriorityQueues.hpp"
+
+/*
+ * Checks the options before any work is done, so a bad heap name is
+ * reported before the graph is loaded
+ */
+bool checkMstOptions(const sMstOptions& options, string* error) {
+	if (options.scheme == HEAP_SCHEME && options.strHeapName != "fheap" && options.strHeapName != "binary"
+			&& options.strHeapName != "4ary" && options.strHeapName != "pairing" && options.strHeapName != "lazy"
+			&& options.strHeapName != "bucket") {
+		*error = "Unknown heap \"" + options.strHeapName + "\"";
+		return EXIT_FAILURE;
+	}
+	if (options.maxBucketKey < 0 || options.maxBucketKey > BUCKET_HEAP_MAX_KEY) {
+		*error = "Bucket limit must be between 0 and " + to_string(BUCKET_HEAP_MAX_KEY);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Checks that an option given on the command line or in a batch manifest
+ * applies to the scheme, the heap options only shape -f and --filter only -k
+ */
+bool checkSchemeOption(eScheme scheme, const string& option, string* error) {
+	if ((option == "--heap" || option == "--insert" || option == "--bucket-limit") && scheme != HEAP_SCHEME)
+		*error = option + " only applies to -f";
+	else if (option == "--filter" && scheme != KRUSKAL_SCHEME)
+		*error = option + " only applies to -k";
+	else
+		return EXIT_SUCCESS;
+	return EXIT_FAILURE;
+}
+
+/*
+ * Runs the scheme on a renumbered copy of the graph and maps the tree back
+ * to the original ids. Renumbering and mapping back are timed in rtime.
+ */
+static bool solveReordered(const sGraph* graph, const sMstOptions& options, uint numOfThreads,
+		sWorkspace* workspace, sMstResult* result) {
+	struct timeval start, end;
+	sGraph permuted;
+	vector<uint> vOrder;
+	sMstOptions permutedOptions = options;
+	permutedOptions.reorder = REORDER_NONE;
+
+	gettimeofday(&start, NULL);
+	computeOrder(graph, options.reorder, vOrder);
+	permuteGraph(graph, vOrder, numOfThreads, &permuted);
+	gettimeofday(&end, NULL);
+	long rtime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+
+	if (solveMst(&permuted, permutedOptions, workspace, result))
+		return EXIT_FAILURE;
+	gettimeofday(&start, NULL);
+	for (size_t i = 0; i < result->vEdges.size(); i++) {
+		result->vEdges[i].vertexStart = vOrder[result->vEdges[i].vertexStart];
+		result->vEdges[i].vertexEnd = vOrder[result->vEdges[i].vertexEnd];
+	}
+	gettimeofday(&end, NULL);
+	rtime += (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+	result->rtime = rtime;
+	result->strDetails += "Reorder = " + reorderName(options.reorder) + ", Reorder Time = " + to_string(rtime)
+		+ " microseconds\n";
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Computes the MST of the graph with the scheme selected in options. Nothing
+ * is printed, the tree, timings and any error are left in result.
+ */
+bool solveMst(const sGraph* graph, const sMstOptions& options, sWorkspace* workspace, sMstResult* result) {
+	sWorkspace localWorkspace;
+	if (!workspace)
+		workspace = &localWorkspace;
+	result->clear();
+	if (checkMstOptions(options, &result->strError))
+		return EXIT_FAILURE;
+	if (graph->numOfNodes == 0) {
+		result->strError = "Graph has no vertices";
+		return EXIT_FAILURE;
+	}
+	const uint numOfThreads = options.numOfThreads ? options.numOfThreads : defaultThreadCount();
+	if (options.bForest)
+		return generateMSTForestScheme(graph, options, numOfThreads, result);
+	if (options.reorder != REORDER_NONE)
+		return solveReordered(graph, options, numOfThreads, workspace, result);
+
+	switch (options.scheme) {
+	case SIMPLE_SCHEME:
+		return generateMSTSimpleScheme(graph, *workspace, result);
+	case BORUVKA_SCHEME:
+		return generateMSTBoruvkaScheme(graph, numOfThreads, result);
+	case DENSE_SCHEME:
+		return generateMSTDenseScheme(graph, numOfThreads, result);
+	case KRUSKAL_SCHEME:
+		return generateMSTKruskalScheme(graph, options.bFilterKruskal, result);
+	default:
+		return generateMSTHeapScheme(graph, options.strHeapName, options.bEagerInsert, options.maxBucketKey,
+				*workspace, result);
+	}
+}
+
+/*
+ * Turns the tree edges of a result into a parent array, every tree rooted
+ * at its smallest vertex, which is its own parent. Works for every scheme,
+ * whatever order the edges were found in, and for forests.
+ */
+void buildParentArray(const sMstResult& result, uint numOfNodes, vector<uint>& vParents) {
+	vParents.assign(numOfNodes, 0);
+	if (numOfNodes == 0)
+		return;
+	// Tree adjacency in CSR form, then a breadth first walk of every tree
+	vector<uint> vOffsets(numOfNodes + 1, 0), vAdj(2 * result.vEdges.size()), vQueue;
+	for (vector<sEdge>::const_iterator it = result.vEdges.begin(); it != result.vEdges.end(); it++) {
+		vOffsets[it->vertexStart + 1]++;
+		vOffsets[it->vertexEnd + 1]++;
+	}
+	for (uint v = 0; v < numOfNodes; v++)
+		vOffsets[v+1] += vOffsets[v];
+	vector<uint> pos(vOffsets.begin(), vOffsets.end() - 1);
+	for (vector<sEdge>::const_iterator it = result.vEdges.begin(); it != result.vEdges.end(); it++) {
+		vAdj[pos[it->vertexStart]++] = it->vertexEnd;
+		vAdj[pos[it->vertexEnd]++] = it->vertexStart;
+	}
+	vector<bool> vSeen(numOfNodes, false);
+	vQueue.reserve(numOfNodes);
+	// One breadth first walk per tree, from its smallest vertex
+	for (uint root = 0; root < numOfNodes; root++) {
+		if (vSeen[root])
+			continue;
+		vSeen[root] = true;
+		vParents[root] = root;
+		vQueue.push_back(root);
+		for (size_t i = vQueue.size() - 1; i < vQueue.size(); i++) {
+			const uint u = vQueue[i];
+			for (uint e = vOffsets[u]; e < vOffsets[u+1]; e++) {
+				if (!vSeen[vAdj[e]]) {
+					vSeen[vAdj[e]] = true;
+					vParents[vAdj[e]] = u;
+					vQueue.push_back(vAdj[e]);
+				}
+			}
+		}
+	}
+}
+
+/* Algorithm :
+		1.	Maintain an array on the vertices V (G).
+		2. 	Put s in the queue, where s is the start vertex. Give s a key of 0.
+			Add all other vertices and set their key to infinity.
+		3. 	Repeatedly get the minimum-key vertex v from the array and mark it scanned.
+			For each neighbor w of v do:
+				If w is not scanned (so far), decrease its key to the min[cost(v,w) , w’s currentkey]
+	Instantiated for the cost width of the graph, adjCost is its cost array.
+*/
+template <class Cost>
+static bool generateMSTSimpleScheme(const sGraph* graph, const Cost* adjCost, sWorkspace& workspace,
+		sMstResult* result) {
+	const uint numOfNodes = graph->numOfNodes;
+	struct timeval start, end;
+	long seconds, useconds;
+	workspace.reserve(numOfNodes);
+	// the final MST will be stored in vMstOutput, without the root's entry
+	vector<sEdge>& vMstOutput = result->vEdges;
+	vMstOutput.resize(numOfNodes ? numOfNodes - 1 : 0);
+	uint curMstIdx = 0;
+	// Array to hold costs. Initially every vertex has infinity cost
+	int* curMstNodes = &workspace.vKeys[0];
+	// For recording parent from where the node can be accessed with the least cost
+	uint* vParentIds = &workspace.vParentIds[0];
+	vector<bool>& visited = workspace.vVisited;
+	// Vertices with a cost, any int is a valid cost so none is kept for infinity
+	vector<bool>& reached = workspace.vReached;
+
+	uint extractedVertexIdx = 0;
+	int64_t totalCost = 0;
+	int extractedCost = 0;
+
+
+	// Adding root to the spanning tree initially and setting other node cost to infinity
+	curMstNodes[0]= 0;
+	vParentIds[0] = 0;
+	visited[0] = false;
+	reached[0] = true;
+	for(uint i=1; i < numOfNodes ;i++) {
+		visited[i] = false;
+		reached[i] = false;
+		curMstNodes[i] = UNREACHED_KEY;
+	}
+
+	// Start recording the time
+	gettimeofday(&start, NULL);
+
+	while(curMstIdx < numOfNodes) {
+
+		bool bExtracted = false;
+
+		//Find the min element
+		for(uint i=0; i < numOfNodes; i++) {
+			if(reached[i] && !visited[i] && (!bExtracted || curMstNodes[i] < extractedCost)) {
+				extractedCost = curMstNodes[i];
+				extractedVertexIdx = i;
+				bExtracted = true;
+			}
+		}
+		if(!bExtracted) {
+			result->strError = "Graph is not connected, it has no spanning tree";
+			return EXIT_FAILURE;
+		}
+		visited[extractedVertexIdx] = true;
+#ifdef LOG_ON
+		cout << "nextMin = " << extractedVertexIdx << " cost = " << extractedCost << endl;
+#endif
+
+		if(curMstIdx > 0) {
+			vMstOutput[curMstIdx-1].vertexStart = vParentIds[extractedVertexIdx];
+			vMstOutput[curMstIdx-1].vertexEnd = extractedVertexIdx;
+			vMstOutput[curMstIdx-1].cost = extractedCost;
+		}
+		totalCost +=  extractedCost;
+
+		// Iterate through all the edges of the vertex and set the cost if cost < currentCost
+		const uint64_t edgeEnd = graph->offsets[extractedVertexIdx+1];
+		for (uint64_t e = graph->offsets[extractedVertexIdx]; e < edgeEnd; e++) {
+			const uint w = graph->adjVertex[e];
+#ifdef LOG_ON
+			cout << extractedVertexIdx << "->" << w << ":" << (int)adjCost[e] << endl;
+#endif
+			if(!visited[w] && (!reached[w] || (int)adjCost[e] < curMstNodes[w])) {
+				curMstNodes[w] = adjCost[e];
+				vParentIds[w] = extractedVertexIdx;
+				reached[w] = true;
+			}
+		}
+#ifdef LOG_ON
+		cout << endl;
+#endif
+		curMstIdx++;
+	}
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = totalCost;
+
+	return EXIT_SUCCESS;
+}
+
+bool generateMSTSimpleScheme(const sGraph* graph, sWorkspace& workspace, sMstResult* result) {
+	if (graph->costType == COST_UINT16)
+		return generateMSTSimpleScheme(graph, graph->adjCost16, workspace, result);
+	return generateMSTSimpleScheme(graph, graph->adjCost, workspace, result);
+}
+
+#ifdef FHEAP_STATS
+// Only the F-heap counts its operations
+template <class Heap> static void printHeapStatistics(ostream&, const Heap&) {}
+static void printHeapStatistics(ostream& out, const FIndexHeap& heap) {
+	out << heap.statistics();
+}
+#endif
+
+/* Algorithm :
+		1.	Maintain a priority queue on the vertices V (G).
+		2. 	Put s in the queue, where s is the start vertex. Give s a key of 0.
+			Add all other vertices and set their key to infinity, or in lazy mode
+			add every other vertex when it's first reached through an edge.
+		3. 	Repeatedly delete the minimum-key vertex v from the queue and mark it scanned.
+			For each neighbor w of v do:
+				If w is not scanned (so far), decrease its key to the min[cost(v,w) , w’s currentkey]
+	Instantiated for the heap and the cost width of the graph, adjCost is its
+	cost array.
+*/
+template <class Heap, class Cost>
+static bool generateMSTHeapScheme(const sGraph* graph, const Cost* adjCost, bool bEagerInsert,
+		sWorkspace& workspace, sMstResult* result) {
+	const uint numOfNodes = graph->numOfNodes;
+	workspace.reserve(numOfNodes);
+	// the final MST will be stored in vMstOutput, without the root's entry
+	vector<sEdge>& vMstOutput = result->vEdges;
+	vMstOutput.resize(numOfNodes ? numOfNodes - 1 : 0);
+	uint curMstIdx = 0, extractedVertexIdx;
+	int64_t totalCost = 0;
+	// Best known cost of every vertex, only valid once an edge reached it
+	int* vKeys = &workspace.vKeys[0];
+	// For recording parent from where the node can be accessed with the least cost
+	uint* vParentIds = &workspace.vParentIds[0];
+	vector<bool>& visited = workspace.vVisited;
+	vector<bool>& reached = workspace.vReached;
+	vector<bool>& inHeap = workspace.vInHeap;
+
+	struct timeval start, end;
+	long seconds, useconds;
+	gettimeofday(&start, NULL);
+
+	// Preallocated heap, node i of the heap holds vertex i
+	Heap vertexHeap(numOfNodes);
+
+	// Setting root node's key to 0 and others to infinity. In lazy mode only
+	// the root goes into the heap, the others when an edge first reaches them
+	vertexHeap.insert(0,0);
+	vKeys[0] = 0;
+	vParentIds[0] = 0;
+	visited[0] = false;
+	reached[0] = true;
+	inHeap[0] = true;
+	for(uint i=1; i < numOfNodes ;i++) {
+		visited[i] = false;
+		reached[i] = false;
+		inHeap[i] = bEagerInsert;
+		vKeys[i] = UNREACHED_KEY;
+		if(bEagerInsert)
+			vertexHeap.insert(i,UNREACHED_KEY);
+	}
+
+	while(curMstIdx < numOfNodes) {
+
+		//Find the min element by using removeMin
+		if(vertexHeap.empty())
+			break;
+		extractedVertexIdx = vertexHeap.minimum();
+		const int extractedCost = vertexHeap.key(extractedVertexIdx);
+		vertexHeap.removeMinimum();
+		inHeap[extractedVertexIdx] = false;
+		// An eager vertex no edge reached yet, tied at UNREACHED_KEY with a
+		// reached one of that cost. It goes back in if an edge reaches it
+		if(!reached[extractedVertexIdx])
+			continue;
+		visited[extractedVertexIdx]  = true;
+
+		//Store in MST for later use
+		if(curMstIdx > 0) {
+			vMstOutput[curMstIdx-1].vertexStart = vParentIds[extractedVertexIdx];
+			vMstOutput[curMstIdx-1].vertexEnd = extractedVertexIdx;
+			vMstOutput[curMstIdx-1].cost = extractedCost;
+		}
+		totalCost +=  extractedCost;
+
+		// Iterate through all the edges of the vertex, insert the vertices
+		// reached for the first time and do the decreaseKey if cost < currentCost
+		const uint64_t edgeEnd = graph->offsets[extractedVertexIdx+1];
+		for(uint64_t e = graph->offsets[extractedVertexIdx]; e < edgeEnd; e++) {
+			const uint w = graph->adjVertex[e];
+			const int cost = adjCost[e];
+			if(!visited[w] && (!reached[w] || cost < vKeys[w])) {
+				// An eager vertex still keyed UNREACHED_KEY needs no change for a cost that equals it
+				if(!inHeap[w])
+					vertexHeap.insert(w,cost);
+				else if(cost < vertexHeap.key(w))
+					vertexHeap.decreaseKey(w,cost);
+				inHeap[w] = true;
+				reached[w] = true;
+				vKeys[w] = cost;
+				vParentIds[w] = extractedVertexIdx;
+			}
+		}
+		curMstIdx++;
+	}
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = totalCost;
+
+	if(curMstIdx < numOfNodes) {
+		result->strError = "Graph is not connected, it has no spanning tree";
+		return EXIT_FAILURE;
+	}
+#ifdef FHEAP_STATS
+	ostringstream details;
+	printHeapStatistics(details, vertexHeap);
+	result->strDetails = details.str();
+#endif
+
+	return EXIT_SUCCESS;
+}
+
+template <class Heap>
+static bool generateMSTHeapScheme(const sGraph* graph, bool bEagerInsert, sWorkspace& workspace, sMstResult* result) {
+	if (graph->costType == COST_UINT16)
+		return generateMSTHeapScheme<Heap>(graph, graph->adjCost16, bEagerInsert, workspace, result);
+	return generateMSTHeapScheme<Heap>(graph, graph->adjCost, bEagerInsert, workspace, result);
+}
+
+/*
+ * F-heap scheme. Prim's algorithm driven by the preallocated F-heap
+ */
+bool generateMSTFibonacciScheme(const sGraph* graph, sWorkspace& workspace, sMstResult* result) {
+	return generateMSTHeapScheme<FIndexHeap>(graph, false, workspace, result);
+}
+
+/*
+ * Whether every cost of the graph is a bucket of the bucket heap. 16-bit
+ * costs fit the default limit without looking at them.
+ */
+static bool costsFitBuckets(const sGraph* graph, int maxBucketKey) {
+	if (graph->costType == COST_UINT16 && maxBucketKey >= NARROW_COST_MAX)
+		return true;
+	const uint64_t numOfSlots = graph->offsets[graph->numOfNodes];
+	for (uint64_t e = 0; e < numOfSlots; e++) {
+		const int cost = graph->cost(e);
+		if (cost < 0 || cost > maxBucketKey)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Runs Prim's algorithm with the priority queue selected by name. The
+ * bucket heap needs every cost in [0, maxBucketKey], other graphs fall
+ * back to the binary heap.
+ */
+bool generateMSTHeapScheme(const sGraph* graph, const string& heapName, bool bEagerInsert,
+		int maxBucketKey, sWorkspace& workspace, sMstResult* result) {
+	if (heapName == "fheap")
+		return generateMSTHeapScheme<FIndexHeap>(graph, bEagerInsert, workspace, result);
+	else if (heapName == "binary")
+		return generateMSTHeapScheme<BinaryHeap>(graph, bEagerInsert, workspace, result);
+	else if (heapName == "4ary")
+		return generateMSTHeapScheme<QuaternaryHeap>(graph, bEagerInsert, workspace, result);
+	else if (heapName == "pairing")
+		return generateMSTHeapScheme<PairingHeap>(graph, bEagerInsert, workspace, result);
+	else if (heapName == "lazy")
+		return generateMSTHeapScheme<LazyHeap>(graph, bEagerInsert, workspace, result);
+	else if (heapName == "bucket") {
+		if (costsFitBuckets(graph, maxBucketKey))
+			return generateMSTHeapScheme<BucketHeap>(graph, bEagerInsert, workspace, result);
+		if (generateMSTHeapScheme<BinaryHeap>(graph, bEagerInsert, workspace, result))
+			return EXIT_FAILURE;
+		result->strDetails += "Costs outside [0, " + to_string(maxBucketKey) + "], used the binary heap\n";
+		return EXIT_SUCCESS;
+	}
+
+	result->strError = "Unknown heap \"" + heapName + "\"";
+	return EXIT_FAILURE;
+}
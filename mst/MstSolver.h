@@ -0,0 +1,100 @@
+/*
+ * MstSolver.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef MSTSOLVER_H_
+#define MSTSOLVER_H_
+
+#include <string>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+#include "Reorder.h"
+
+// MST scheme run by solveMst
+enum eScheme { SIMPLE_SCHEME, HEAP_SCHEME, KRUSKAL_SCHEME, BORUVKA_SCHEME, DENSE_SCHEME };
+
+// How solveMst computes the tree, the defaults match the mst command line
+struct sMstOptions {
+	eScheme scheme;
+	// Priority queue of the heap scheme: fheap, binary, 4ary, pairing, lazy, bucket
+	string strHeapName;
+	// Largest cost the bucket heap takes, above it the binary heap is used
+	int maxBucketKey;
+	// Insert every vertex into the heap up front instead of when it's reached
+	bool bEagerInsert;
+	// Filter-Kruskal instead of plain Kruskal
+	bool bFilterKruskal;
+	// Minimum spanning forest, every connected component solved on its own
+	bool bForest;
+	// Vertex renumbering done before the scheme runs
+	eReorder reorder;
+	// Worker threads of the parallel schemes, 0 means one per core
+	uint numOfThreads;
+
+	sMstOptions():
+		scheme(HEAP_SCHEME),strHeapName("fheap"),maxBucketKey(NARROW_COST_MAX),bEagerInsert(false),
+		bFilterKruskal(false),bForest(false),reorder(REORDER_NONE),numOfThreads(0) {}
+};
+
+// One tree of a minimum spanning forest
+struct sMstComponent {
+	// Smallest vertex of the component
+	uint root;
+	uint numOfNodes;
+	// The numOfNodes-1 edges of the tree start at vEdges[firstEdge]
+	uint64_t firstEdge;
+	int64_t totalCost;
+};
+
+// Tree found by a scheme. Reusing a result across calls keeps its buffer
+struct sMstResult {
+	// The numOfNodes-1 tree edges, in the order the scheme found them. In
+	// forest mode the edges of every tree, one tree after the other
+	vector<sEdge> vEdges;
+	// Trees of the forest in the order of their smallest vertex, forest mode only
+	vector<sMstComponent> vComponents;
+	int64_t totalCost;
+	// Time the scheme took in microseconds, loading the graph not included
+	long mtime;
+	// Time the vertex reordering took in microseconds, not part of mtime
+	long rtime;
+	// Scheme specific report, e.g. the thread and round counts of Boruvka
+	string strDetails;
+	// Why the scheme failed, e.g. the graph isn't connected
+	string strError;
+
+	sMstResult():
+		totalCost(0),mtime(0),rtime(0) {}
+
+	void clear() {
+		vEdges.clear();
+		vComponents.clear();
+		totalCost = 0;
+		mtime = 0;
+		rtime = 0;
+		strDetails.clear();
+		strError.clear();
+	}
+};
+
+/*
+ * Library entry points. They keep no state of their own and only read the
+ * graph, so any number of threads may call them at once, on the same graph
+ * or on different ones, as long as every thread passes its own workspace
+ * and result. A NULL workspace uses a temporary one for the call.
+ */
+bool checkMstOptions(const sMstOptions& options, string* error);
+bool checkSchemeOption(eScheme scheme, const string& option, string* error);
+bool solveMst(const sGraph* graph, const sMstOptions& options, sWorkspace* workspace, sMstResult* result);
+void buildParentArray(const sMstResult& result, uint numOfNodes, vector<uint>& vParents);
+
+bool generateMSTSimpleScheme(const sGraph* graph, sWorkspace& workspace, sMstResult* result);
+bool generateMSTFibonacciScheme(const sGraph* graph, sWorkspace& workspace, sMstResult* result);
+bool generateMSTHeapScheme(const sGraph* graph, const string& heapName, bool bEagerInsert,
+		int maxBucketKey, sWorkspace& workspace, sMstResult* result);
+
+#endif /* MSTSOLVER_H_ */
@@ -0,0 +1,147 @@
+/*
+ * Parallel.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Number of worker threads used when none is given on the command line
+inline uint defaultThreadCount() {
+	const uint n = thread::hardware_concurrency();
+	return n ? n : 1;
+}
+
+/*
+ * Splits [0, count) into numOfThreads contiguous chunks and runs
+ * body(thread, begin, end) on each of them. Chunk 0 runs on the calling
+ * thread, the others on their own threads.
+ */
+template <class Body>
+inline void parallelFor(uint numOfThreads, size_t count, Body body) {
+	if (numOfThreads <= 1 || count < 2 * numOfThreads) {
+		body(0, (size_t)0, count);
+		return;
+	}
+	vector<thread> workers;
+	workers.reserve(numOfThreads - 1);
+	for (uint t = 1; t < numOfThreads; t++) {
+		const size_t begin = count * t / numOfThreads;
+		const size_t end = count * (t + 1) / numOfThreads;
+		workers.push_back(thread(body, t, begin, end));
+	}
+	body(0, (size_t)0, count / numOfThreads);
+	for (uint t = 0; t < workers.size(); t++)
+		workers[t].join();
+}
+
+/*
+ * Runs body(thread) once for every thread id in [0, numOfThreads),
+ * thread 0 on the calling thread.
+ */
+template <class Body>
+inline void parallelRun(uint numOfThreads, Body body) {
+	vector<thread> workers;
+	for (uint t = 1; t < numOfThreads; t++)
+		workers.push_back(thread(body, t));
+	body(0);
+	for (uint t = 0; t < workers.size(); t++)
+		workers[t].join();
+}
+
+// Jobs [next, last) still queued on one thread of parallelJobs
+struct sJobQueue {
+	mutex lock;
+	size_t next;
+	size_t last;
+};
+
+/*
+ * Runs body(thread, job) once for every job in [0, numOfJobs) on a work
+ * stealing pool, thread 0 being the calling thread. Every thread starts on
+ * its own contiguous share of the jobs and takes them from the front. A
+ * thread that runs dry steals the back half of another thread's share, so
+ * jobs of very different sizes still keep every thread busy.
+ */
+template <class Body>
+inline void parallelJobs(uint numOfThreads, size_t numOfJobs, Body body) {
+	if (numOfThreads == 0)
+		numOfThreads = 1;
+	vector<sJobQueue> queues(numOfThreads);
+	for (uint t = 0; t < numOfThreads; t++) {
+		queues[t].next = numOfJobs * t / numOfThreads;
+		queues[t].last = numOfJobs * (t + 1) / numOfThreads;
+	}
+	parallelRun(numOfThreads, [&](uint t) {
+		sJobQueue& own = queues[t];
+		for (;;) {
+			size_t job = numOfJobs;
+			{
+				lock_guard<mutex> guard(own.lock);
+				if (own.next < own.last)
+					job = own.next++;
+			}
+			// Own share is done, steal half of the first share that has jobs left.
+			// No new jobs appear, so after a pass that finds none this thread is
+			// done and whatever is still queued belongs to a running thread
+			for (uint k = 1; job == numOfJobs && k < numOfThreads; k++) {
+				sJobQueue& victim = queues[(t + k) % numOfThreads];
+				size_t first, last;
+				{
+					lock_guard<mutex> guard(victim.lock);
+					if (victim.next >= victim.last)
+						continue;
+					last = victim.last;
+					first = victim.next + (victim.last - victim.next) / 2;
+					victim.last = first;
+				}
+				lock_guard<mutex> guard(own.lock);
+				own.next = first + 1;
+				own.last = last;
+				job = first;
+			}
+			if (job == numOfJobs)
+				return;
+			body(t, job);
+		}
+	});
+}
+
+/*
+ * Reusable barrier for a fixed number of threads. Waiters spin on the
+ * generation counter and yield, which keeps the short lock step phases of
+ * the dense scheme cheap without starving an oversubscribed core.
+ */
+struct sSpinBarrier {
+	const uint numOfThreads;
+	atomic<uint> waiting;
+	atomic<uint> generation;
+
+	explicit sSpinBarrier(uint n):
+		numOfThreads(n), waiting(0), generation(0) {}
+
+	void wait() {
+		if (numOfThreads <= 1)
+			return;
+		const uint gen = generation.load(memory_order_acquire);
+		if (waiting.fetch_add(1, memory_order_acq_rel) + 1 == numOfThreads) {
+			waiting.store(0, memory_order_relaxed);
+			generation.store(gen + 1, memory_order_release);
+			return;
+		}
+		for (uint spins = 0; generation.load(memory_order_acquire) == gen; spins++)
+			if (spins >= 64)
+				this_thread::yield();
+	}
+};
+
+#endif /* PARALLEL_H_ */
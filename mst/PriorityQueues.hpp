@@ -0,0 +1,442 @@
+/*
+ * PriorityQueues.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ *
+ *  Indexed priority queues that can stand in for FIndexHeap in the Prim
+ *  driver. All of them follow the same policy interface:
+ *
+ *    Heap(capacity)               - data ids are 0..capacity-1
+ *    insert(data, key)
+ *    minimum()                    - data with the smallest key
+ *    key(data)                    - current key of data
+ *    removeMinimum()
+ *    decreaseKey(data, newKey)
+ *    empty(), size()
+ */
+#ifndef PRIORITYQUEUES_HPP_
+#define PRIORITYQUEUES_HPP_
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <stdint.h>
+#include <stdlib.h>
+#include "Global.h"
+using namespace std;
+
+// Largest key BucketHeap can hold, three levels of 64-bit occupancy words
+#define BUCKET_HEAP_MAX_KEY ((1 << 18) - 1)
+
+/*
+ * Implicit d-ary min heap with a position index for decreaseKey.
+ * D = 2 is the classic binary heap, D = 4 trades deeper sift-downs for
+ * shorter trees and better cache behaviour.
+ */
+template <uint D>
+class DaryHeap {
+	enum { NIL = 0xFFFFFFFF };
+
+	// heap[i] is the data stored at heap position i
+	vector<uint32_t> heap;
+	// pos[data] is the heap position of data
+	vector<uint32_t> pos;
+	vector<int> keys;
+	uint count;
+
+	void siftUp(uint i) {
+		const uint32_t data = heap[i];
+		const int k = keys[data];
+		while (i > 0) {
+			const uint parent = (i - 1) / D;
+			if (keys[heap[parent]] <= k)
+				break;
+			heap[i] = heap[parent];
+			pos[heap[i]] = i;
+			i = parent;
+		}
+		heap[i] = data;
+		pos[data] = i;
+	}
+
+	void siftDown(uint i) {
+		const uint32_t data = heap[i];
+		const int k = keys[data];
+		while (true) {
+			const uint first = i * D + 1;
+			if (first >= count)
+				break;
+			const uint last = min(first + D, count);
+			uint best = first;
+			for (uint c = first + 1; c < last; c++) {
+				if (keys[heap[c]] < keys[heap[best]])
+					best = c;
+			}
+			if (k <= keys[heap[best]])
+				break;
+			heap[i] = heap[best];
+			pos[heap[i]] = i;
+			i = best;
+		}
+		heap[i] = data;
+		pos[data] = i;
+	}
+
+public:
+	explicit DaryHeap(uint capacity):
+		heap(capacity), pos(capacity, NIL), keys(capacity), count(0) {}
+
+	bool empty() const { return count == 0; }
+	uint size() const { return count; }
+
+	uint32_t minimum() const {
+		if (count == 0) {
+			cout << "Heap Error: No min element" << endl;
+			exit(EXIT_FAILURE);
+		}
+		return heap[0];
+	}
+
+	int key(uint32_t data) const { return keys[data]; }
+
+	void insert(uint32_t data, int key) {
+		keys[data] = key;
+		heap[count] = data;
+		siftUp(count++);
+	}
+
+	void removeMinimum() {
+		if (count == 0) {
+			cout << "Heap Error: trying to remove from an empty heap" << endl;
+			exit(EXIT_FAILURE);
+		}
+		pos[heap[0]] = NIL;
+		if (--count > 0) {
+			heap[0] = heap[count];
+			siftDown(0);
+		}
+	}
+
+	void decreaseKey(uint32_t data, int newKey) {
+		if (newKey >= keys[data]) {
+			cout << "Trying to decrease key to a greater key" << endl;
+			exit(EXIT_FAILURE);
+		}
+		keys[data] = newKey;
+		siftUp(pos[data]);
+	}
+};
+
+typedef DaryHeap<2> BinaryHeap;
+typedef DaryHeap<4> QuaternaryHeap;
+
+/*
+ * Pairing heap over a preallocated node array. decreaseKey cuts the
+ * subtree and melds it with the root, removeMinimum does the standard
+ * two-pass pairing of the root's children.
+ */
+class PairingHeap {
+	enum { NIL = 0xFFFFFFFF };
+
+	struct sPNode {
+		int key;
+		uint32_t child;
+		// Next sibling
+		uint32_t next;
+		// Previous sibling, or the parent for the first child
+		uint32_t previous;
+	};
+
+	vector<sPNode> nodes;
+	// Scratch list of subtrees used by removeMinimum, kept between calls
+	vector<uint32_t> subtrees;
+	uint32_t root;
+	uint count;
+
+	// Meld two detached trees, returns the new root
+	uint32_t meld(uint32_t a, uint32_t b) {
+		if (nodes[b].key < nodes[a].key)
+			swap(a, b);
+		sPNode& parent = nodes[a];
+		sPNode& c = nodes[b];
+		c.next = parent.child;
+		if (parent.child != NIL)
+			nodes[parent.child].previous = b;
+		c.previous = a;
+		parent.child = b;
+		return a;
+	}
+
+public:
+	explicit PairingHeap(uint capacity):
+		nodes(capacity), root(NIL), count(0) {}
+
+	bool empty() const { return count == 0; }
+	uint size() const { return count; }
+
+	uint32_t minimum() const {
+		if (root == NIL) {
+			cout << "Heap Error: No min element" << endl;
+			exit(EXIT_FAILURE);
+		}
+		return root;
+	}
+
+	int key(uint32_t data) const { return nodes[data].key; }
+
+	void insert(uint32_t data, int key) {
+		sPNode& n = nodes[data];
+		n.key = key;
+		n.child = n.next = n.previous = NIL;
+		root = (root == NIL) ? data : meld(root, data);
+		count++;
+	}
+
+	void removeMinimum() {
+		if (root == NIL) {
+			cout << "Heap Error: trying to remove from an empty heap" << endl;
+			exit(EXIT_FAILURE);
+		}
+		count--;
+		// Detach the children of the root
+		subtrees.clear();
+		for (uint32_t c = nodes[root].child; c != NIL; ) {
+			const uint32_t next = nodes[c].next;
+			nodes[c].next = nodes[c].previous = NIL;
+			subtrees.push_back(c);
+			c = next;
+		}
+		nodes[root].child = NIL;
+		if (subtrees.empty()) {
+			root = NIL;
+			return;
+		}
+
+		// First pass: meld pairs left to right
+		uint paired = 0;
+		for (uint i = 0; i + 1 < subtrees.size(); i += 2)
+			subtrees[paired++] = meld(subtrees[i], subtrees[i+1]);
+		if (subtrees.size() % 2)
+			subtrees[paired++] = subtrees.back();
+
+		// Second pass: meld right to left into a single tree
+		uint32_t newRoot = subtrees[paired-1];
+		for (uint i = paired - 1; i > 0; i--)
+			newRoot = meld(subtrees[i-1], newRoot);
+		root = newRoot;
+	}
+
+	void decreaseKey(uint32_t data, int newKey) {
+		sPNode& n = nodes[data];
+		if (newKey >= n.key) {
+			cout << "Trying to decrease key to a greater key" << endl;
+			exit(EXIT_FAILURE);
+		}
+		n.key = newKey;
+		if (data == root)
+			return;
+
+		// Cut the subtree rooted at data and meld it back with the root
+		if (nodes[n.previous].child == data)
+			nodes[n.previous].child = n.next;
+		else
+			nodes[n.previous].next = n.next;
+		if (n.next != NIL)
+			nodes[n.next].previous = n.previous;
+		n.next = n.previous = NIL;
+		root = meld(root, data);
+	}
+};
+
+/*
+ * Decrease-key free queue on top of std::priority_queue. decreaseKey pushes
+ * a second entry and the outdated one is skipped when it reaches the top
+ * (lazy deletion), so the top of the queue is always a live entry.
+ */
+class LazyHeap {
+	typedef pair<int, uint32_t> tEntry;
+
+	priority_queue<tEntry, vector<tEntry>, greater<tEntry> > queue;
+	vector<int> keys;
+	vector<bool> inHeap;
+	uint count;
+
+	// Pop outdated entries until the top is live again
+	void dropStale() {
+		while (!queue.empty()) {
+			const tEntry& top = queue.top();
+			if (inHeap[top.second] && keys[top.second] == top.first)
+				break;
+			queue.pop();
+		}
+	}
+
+public:
+	explicit LazyHeap(uint capacity):
+		keys(capacity), inHeap(capacity, false), count(0) {}
+
+	bool empty() const { return count == 0; }
+	uint size() const { return count; }
+
+	uint32_t minimum() const {
+		if (count == 0) {
+			cout << "Heap Error: No min element" << endl;
+			exit(EXIT_FAILURE);
+		}
+		return queue.top().second;
+	}
+
+	int key(uint32_t data) const { return keys[data]; }
+
+	void insert(uint32_t data, int key) {
+		keys[data] = key;
+		inHeap[data] = true;
+		queue.push(tEntry(key, data));
+		count++;
+	}
+
+	void removeMinimum() {
+		if (count == 0) {
+			cout << "Heap Error: trying to remove from an empty heap" << endl;
+			exit(EXIT_FAILURE);
+		}
+		inHeap[queue.top().second] = false;
+		queue.pop();
+		count--;
+		dropStale();
+	}
+
+	void decreaseKey(uint32_t data, int newKey) {
+		if (newKey >= keys[data]) {
+			cout << "Trying to decrease key to a greater key" << endl;
+			exit(EXIT_FAILURE);
+		}
+		keys[data] = newKey;
+		queue.push(tEntry(newKey, data));
+	}
+};
+
+/*
+ * Bucket queue for small non-negative integer keys, one bucket per key.
+ * Every bucket is an intrusive doubly linked list threaded through arrays
+ * indexed by data, so insert, decreaseKey and removal are O(1) list
+ * splices. Prim's keys are not monotone, so the smallest non-empty bucket
+ * is found with a three level bitmap of non-empty buckets, three
+ * count-trailing-zeros instead of a scan. Buckets are added as larger keys
+ * arrive, up to BUCKET_HEAP_MAX_KEY. Keys of UNREACHED_KEY (eager insert)
+ * wait in a list of their own behind every bucket.
+ */
+class BucketHeap {
+	enum { NIL = 0xFFFFFFFF };
+
+	vector<uint32_t> next;
+	vector<uint32_t> previous;
+	vector<int> keys;
+	// First data of every bucket
+	vector<uint32_t> buckets;
+	// Bit b of level0 is set if bucket b is non-empty, bit w of level1 if
+	// level0[w] is non-zero and bit w of level2 if level1[w] is non-zero
+	vector<uint64_t> level0;
+	vector<uint64_t> level1;
+	uint64_t level2;
+	uint32_t unreached;
+	uint count;
+
+	inline uint32_t& head(int key) {
+		return key == UNREACHED_KEY ? unreached : buckets[key];
+	}
+
+	inline void markBucket(uint b) {
+		level0[b >> 6] |= 1ULL << (b & 63);
+		level1[b >> 12] |= 1ULL << ((b >> 6) & 63);
+		level2 |= 1ULL << (b >> 12);
+	}
+
+	inline void unmarkBucket(uint b) {
+		if ((level0[b >> 6] &= ~(1ULL << (b & 63))) == 0
+				&& (level1[b >> 12] &= ~(1ULL << ((b >> 6) & 63))) == 0)
+			level2 &= ~(1ULL << (b >> 12));
+	}
+
+	// Adds the buckets up to key, in blocks of 64
+	void growBuckets(int key) {
+		if (key < 0 || key > BUCKET_HEAP_MAX_KEY) {
+			cout << "Heap Error: key " << key << " is outside the buckets" << endl;
+			exit(EXIT_FAILURE);
+		}
+		const uint size = ((uint)key | 63) + 1;
+		buckets.resize(size, NIL);
+		level0.resize(size >> 6, 0);
+		level1.resize(((size >> 6) + 63) >> 6, 0);
+	}
+
+	void link(uint32_t data, int key) {
+		if (key != UNREACHED_KEY && (uint)key >= buckets.size())
+			growBuckets(key);
+		uint32_t& first = head(key);
+		keys[data] = key;
+		previous[data] = NIL;
+		next[data] = first;
+		if (first != NIL)
+			previous[first] = data;
+		else if (key != UNREACHED_KEY)
+			markBucket(key);
+		first = data;
+	}
+
+	void unlink(uint32_t data) {
+		const int key = keys[data];
+		if (previous[data] != NIL)
+			next[previous[data]] = next[data];
+		else if ((head(key) = next[data]) == NIL && key != UNREACHED_KEY)
+			unmarkBucket(key);
+		if (next[data] != NIL)
+			previous[next[data]] = previous[data];
+	}
+
+public:
+	explicit BucketHeap(uint capacity):
+		next(capacity), previous(capacity), keys(capacity), level2(0), unreached(NIL), count(0) {}
+
+	bool empty() const { return count == 0; }
+	uint size() const { return count; }
+
+	uint32_t minimum() const {
+		if (count == 0) {
+			cout << "Heap Error: No min element" << endl;
+			exit(EXIT_FAILURE);
+		}
+		if (level2 == 0)
+			return unreached;
+		const uint w1 = __builtin_ctzll(level2);
+		const uint w0 = (w1 << 6) | __builtin_ctzll(level1[w1]);
+		return buckets[(w0 << 6) | __builtin_ctzll(level0[w0])];
+	}
+
+	int key(uint32_t data) const { return keys[data]; }
+
+	void insert(uint32_t data, int key) {
+		link(data, key);
+		count++;
+	}
+
+	void removeMinimum() {
+		unlink(minimum());
+		count--;
+	}
+
+	void decreaseKey(uint32_t data, int newKey) {
+		if (newKey >= keys[data]) {
+			cout << "Trying to decrease key to a greater key" << endl;
+			exit(EXIT_FAILURE);
+		}
+		unlink(data);
+		link(data, newKey);
+	}
+};
+
+#endif /* PRIORITYQUEUES_HPP_ */
@@ -5,99 +5,200 @@
  *  Author: Sagar
  */
 #include "RandomGraph.h"
+#include "Parallel.h"
 
 using namespace std;
 
-// Number of nodes visited by DFS (should be equal to numOfNodes)
-static uint numOfNodesVisitedByDfs = 0;
-// boolean array returning if v1->v2 are connected
-static bool	bGenVert[MAX_NODES][MAX_NODES] = {};
+// The pair space is cut into this many blocks of rows, each sampled with its
+// own stream. Fixed, so the graph doesn't depend on the number of threads
+#define RANDOM_GRAPH_BLOCKS 256
+// Parent of the root of the spanning tree
+#define NO_PARENT 0xFFFFFFFFu
+
 /*
- * Generates a random graph and checks for connectivity using DFS
+ * Counter based random stream (splitmix64). Stream s of a seed is the
+ * sequence mix(start + k * gamma), so every block gets an independent,
+ * reproducible stream without any shared state.
  */
-bool generateRandomGraph(sVertex* vertices,const uint numOfNodes, const uint density) {
-	uint v1=0,v2=0,cost=0,numOfEdges = 0,numOfEdgeToGen=0;
-	float numOfEdgeToGenFloat = 0;
-	sEdge e1;
-
-	// Calculate number of edges to generate as per density
-	numOfEdgeToGenFloat = ((numOfNodes * (numOfNodes-1)/2) * density);
-	numOfEdgeToGenFloat = numOfEdgeToGenFloat/100;
-	numOfEdgeToGenFloat = ceil(numOfEdgeToGenFloat);
+struct sRandomStream {
+	uint64_t state;
 
-	numOfEdgeToGen = (int) numOfEdgeToGenFloat;
+	static inline uint64_t mix(uint64_t z) {
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+	sRandomStream(uint64_t seed, uint64_t stream):
+		state(mix(seed ^ mix(stream + 1))) {}
 
-	if(numOfEdgeToGen < numOfNodes-1) {
-		cout << "  Error: can't create the graph with less than n-1 edges" << endl;
-		exit(EXIT_FAILURE);
+	inline uint64_t next() {
+		state += 0x9E3779B97F4A7C15ull;
+		return mix(state);
 	}
-	cout << "--> Generating graph with " << numOfNodes << " vertices and " << numOfEdgeToGen << " edges ..." << endl;
-	do {
-		/* initialize random seed */
-		srand (time(NULL));
-		numOfNodesVisitedByDfs = 0;
-		numOfEdges = 0;
-		do {
-			do {
-				v1 = rand() % numOfNodes;
-				v2 = rand() % numOfNodes;
-			} while(v1 == v2);
+	// Uniform in (0, 1]
+	inline double uniform() {
+		return ((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+	}
+	// Uniform in [0, n)
+	inline uint below(uint n) {
+		return (uint)(((next() >> 32) * n) >> 32);
+	}
+	inline int cost() {
+		return below(MAX_COST) + 1;
+	}
+};
 
-			if(!bGenVert[v1][v2] &&  !bGenVert[v2][v1]) {
+/*
+ * Samples the pairs (i, j), i < j, of rows [firstRow, lastRow) with
+ * probability p, skipping the pairs that are already tree edges (row i of
+ * vTreeAdj holds the sorted tree neighbours of i above i). The gap to
+ * the next sampled pair is drawn from the geometric distribution, so the
+ * work is proportional to the number of rows and edges, not pairs.
+ * Called once with vEdges NULL to count and once more to fill, the stream
+ * makes both calls draw the same pairs.
+ */
+static uint64_t sampleBlock(const uint64_t seed, const uint block, const uint firstRow, const uint lastRow,
+		const uint numOfNodes, const vector<uint>& vTreeOffsets, const vector<uint>& vTreeAdj,
+		const double logq, const bool bAll, sEdge* vEdges) {
+	sRandomStream rng(seed, block + 1);
+	uint64_t numOfEdges = 0;
+	uint i = firstRow;
+	uint64_t j = (uint64_t)i + 1;
+	// Next tree edge of row i
+	uint t = 0;
 
-				bGenVert[v1][v2] = true;
-				bGenVert[v2][v1] = true;
+	if (firstRow >= lastRow)
+		return 0;
+	t = vTreeOffsets[i];
+	for (;;) {
+		if (!bAll) {
+			const double skip = log(rng.uniform()) / logq;
+			j += skip < numOfNodes * (double)numOfNodes ? (uint64_t)skip : (uint64_t)numOfNodes * numOfNodes;
+		}
+		// Carry the skip over into the following rows
+		while (i < lastRow && j >= numOfNodes) {
+			const uint64_t excess = j - numOfNodes;
+			i++;
+			j = (uint64_t)i + 1 + excess;
+			t = vTreeOffsets[i];
+		}
+		if (i >= lastRow)
+			break;
+		while (t < vTreeOffsets[i+1] && vTreeAdj[t] < j)
+			t++;
+		if (t == vTreeOffsets[i+1] || vTreeAdj[t] != j) {
+			const int cost = rng.cost();
+			if (vEdges) {
+				vEdges[numOfEdges].vertexStart = i;
+				vEdges[numOfEdges].vertexEnd = (uint)j;
+				vEdges[numOfEdges].cost = cost;
+			}
+			numOfEdges++;
+		}
+		j++;
+	}
+	return numOfEdges;
+}
 
-				cost = rand() % MAX_COST + 1;
+/*
+ * Generates a connected random graph from the given seed.
+ *   1. A random spanning tree: every vertex of a random permutation is joined
+ *      to a random vertex before it.
+ *   2. Every other pair is added with the probability that gives the
+ *      requested density on average, sampled in parallel over blocks of rows.
+ * The same seed always gives the same graph, whatever the number of threads.
+ * Parameters the graph can't be made from fail with strError set.
+ */
+bool generateRandomGraph(sGraph* graph, const uint numOfNodes, const double density,
+		const uint64_t seed, const uint numOfThreads, string& strError) {
+	if (numOfNodes == 0 || numOfNodes == 0xFFFFFFFFu) {
+		strError = "number of nodes must be between 1 and 2^32-2";
+		return EXIT_FAILURE;
+	}
+	// Calculate number of edges to generate as per density, rounded up
+	const uint64_t numOfPairs = (uint64_t)numOfNodes * (numOfNodes-1) / 2;
+	uint64_t numOfEdgeToGen = (uint64_t)ceil((double)numOfPairs * density / 100);
+	if (numOfEdgeToGen > numOfPairs)
+		numOfEdgeToGen = numOfPairs;
 
-				e1.vertexStart = v1;
-				e1.vertexEnd = v2;
-				e1.cost = cost;
-				e1.visited = false;
-				vertices[v1].id = v1;
-				vertices[v1].visited = false;
-				vertices[v1].adj.push_back(e1);
+	if(numOfEdgeToGen < numOfNodes-1) {
+		strError = "can't create the graph with less than n-1 edges";
+		return EXIT_FAILURE;
+	}
 
-				e1.vertexStart = v2;
-				e1.vertexEnd = v1;
-				e1.cost = cost;
-				e1.visited = false;
-				vertices[v2].id = v2;
-				vertices[v2].visited = false;
-				vertices[v2].adj.push_back(e1);
+	// Spanning tree, parent of every vertex but the root
+	sRandomStream rng(seed, 0);
+	vector<uint> vOrder(numOfNodes), vParents(numOfNodes);
+	for (uint v = 0; v < numOfNodes; v++)
+		vOrder[v] = v;
+	for (uint v = numOfNodes - 1; v > 0; v--)
+		swap(vOrder[v], vOrder[rng.below(v + 1)]);
+	vParents[vOrder[0]] = NO_PARENT;
+	for (uint k = 1; k < numOfNodes; k++)
+		vParents[vOrder[k]] = vOrder[rng.below(k)];
 
-				numOfEdges++;
-			}
-		} while (numOfEdges != numOfEdgeToGen);
-		// check connectivity using DFS. Start from 0 and all the nodes should be visited
-		cout << "--> Checking connectivity ..." << endl;
+	// Tree edges by their lower end, sorted, so the sampler walks them along
+	vector<uint> vTreeOffsets(numOfNodes + 1, 0), vTreeAdj(numOfNodes - 1);
+	for (uint v = 0; v < numOfNodes; v++)
+		if (vParents[v] != NO_PARENT)
+			vTreeOffsets[min(v, vParents[v]) + 1]++;
+	for (uint v = 0; v < numOfNodes; v++)
+		vTreeOffsets[v+1] += vTreeOffsets[v];
+	{
+		vector<uint> vPos(vTreeOffsets.begin(), vTreeOffsets.end() - 1);
+		for (uint v = 0; v < numOfNodes; v++)
+			if (vParents[v] != NO_PARENT)
+				vTreeAdj[vPos[min(v, vParents[v])]++] = max(v, vParents[v]);
+	}
+	for (uint v = 0; v < numOfNodes; v++)
+		sort(vTreeAdj.begin() + vTreeOffsets[v], vTreeAdj.begin() + vTreeOffsets[v+1]);
 
-		numOfNodesVisitedByDfs = dfs(vertices,0);
-#ifdef LOG_ON
-	cout << "numOfNodesVisitedByDfs =" << numOfNodesVisitedByDfs << endl;
-#endif
-	} while(numOfNodesVisitedByDfs != numOfNodes);
+	// Probability of every pair that is not a tree edge
+	const uint64_t numOfTreeEdges = numOfNodes - 1;
+	const uint64_t numOfFreePairs = numOfPairs - numOfTreeEdges;
+	const uint64_t numOfExtraEdges = numOfEdgeToGen - numOfTreeEdges;
+	const double p = numOfFreePairs ? (double)numOfExtraEdges / numOfFreePairs : 0;
+	const bool bAll = numOfExtraEdges == numOfFreePairs;
+	const double logq = log1p(-p);
 
-	cout << "--> Graph generated ..." << endl;
-	return EXIT_SUCCESS;
-}
+	// Blocks of rows with about the same number of pairs each
+	vector<uint> vFirstRow(RANDOM_GRAPH_BLOCKS + 1, numOfNodes);
+	vFirstRow[0] = 0;
+	if (numOfExtraEdges > 0) {
+		uint64_t pairsBefore = 0;
+		uint block = 1;
+		for (uint i = 0; i < numOfNodes && block < RANDOM_GRAPH_BLOCKS; i++) {
+			while (block < RANDOM_GRAPH_BLOCKS && pairsBefore >= numOfPairs / RANDOM_GRAPH_BLOCKS * block)
+				vFirstRow[block++] = i;
+			pairsBefore += numOfNodes - 1 - i;
+		}
+	} else {
+		// Just the tree
+		vFirstRow[1] = 0;
+	}
 
-/*
- * Recursive DFS to check the graph connectivity
- */
-uint dfs(sVertex* vertices, uint vertIndex) {
-	if(vertices[vertIndex].visited)
-		return 0;
-	vertices[vertIndex].visited = true;
-	numOfNodesVisitedByDfs++;
-#ifdef LOG_ON
-	cout << "visiting nodeID =" << vertIndex << endl;
-#endif
-	list<sEdge>::iterator it = vertices[vertIndex].adj.begin();
-	if (it == vertices[vertIndex].adj.end())
-		return 0;
-	for (; it != vertices[vertIndex].adj.end(); it++) {
-		dfs(vertices,it->vertexEnd);
+	// Count, place every block and sample again into its place
+	vector<uint64_t> vBlockPos(RANDOM_GRAPH_BLOCKS + 1, 0);
+	parallelFor(numOfThreads, RANDOM_GRAPH_BLOCKS, [&](uint, size_t begin, size_t end) {
+		for (size_t b = begin; b < end; b++)
+			vBlockPos[b+1] = sampleBlock(seed, b, vFirstRow[b], vFirstRow[b+1], numOfNodes,
+					vTreeOffsets, vTreeAdj, logq, bAll, NULL);
+	});
+	vBlockPos[0] = numOfTreeEdges;
+	for (uint b = 0; b < RANDOM_GRAPH_BLOCKS; b++)
+		vBlockPos[b+1] += vBlockPos[b];
+
+	vector<sEdge> vEdges(vBlockPos[RANDOM_GRAPH_BLOCKS]);
+	for (uint k = 1; k < numOfNodes; k++) {
+		vEdges[k-1].vertexStart = vOrder[k];
+		vEdges[k-1].vertexEnd = vParents[vOrder[k]];
+		vEdges[k-1].cost = rng.cost();
 	}
-	return numOfNodesVisitedByDfs;
+	parallelFor(numOfThreads, RANDOM_GRAPH_BLOCKS, [&](uint, size_t begin, size_t end) {
+		for (size_t b = begin; b < end; b++)
+			sampleBlock(seed, b, vFirstRow[b], vFirstRow[b+1], numOfNodes,
+					vTreeOffsets, vTreeAdj, logq, bAll, vEdges.data() + vBlockPos[b]);
+	});
+	buildGraph(graph, numOfNodes, vEdges);
+	return EXIT_SUCCESS;
 }
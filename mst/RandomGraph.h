@@ -12,13 +12,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <iostream>
+#include <algorithm>
 #include <math.h>
-#include <map>
-#include <set>
 #include <stdint.h>
 #include "Global.h"
+#include "Graph.h"
 
-bool generateRandomGraph(sVertex* vertices, const uint numOfNodes, const uint density);
-uint dfs(sVertex* vertices, uint vertIndex);
+bool generateRandomGraph(sGraph* graph, const uint numOfNodes, const double density,
+		const uint64_t seed, const uint numOfThreads, string& strError);
 
 #endif /* RANDOMGRAPH_H_ */
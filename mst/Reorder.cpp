@@ -0,0 +1,159 @@
+/*
+ * Reorder.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <cstring>
+#include "Reorder.h"
+#include "Parallel.h"
+
+/*
+ * Selects the reordering by name: none, bfs, rcm or degree
+ */
+bool parseReorder(const string& name, eReorder* reorder) {
+	if (name == "none")
+		*reorder = REORDER_NONE;
+	else if (name == "bfs")
+		*reorder = REORDER_BFS;
+	else if (name == "rcm")
+		*reorder = REORDER_RCM;
+	else if (name == "degree")
+		*reorder = REORDER_DEGREE;
+	else
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
+
+string reorderName(eReorder reorder) {
+	switch (reorder) {
+	case REORDER_BFS:
+		return "bfs";
+	case REORDER_RCM:
+		return "rcm";
+	case REORDER_DEGREE:
+		return "degree";
+	default:
+		return "none";
+	}
+}
+
+// Vertices by degree, ties by id, with a counting sort over the degrees
+static void sortByDegree(const sGraph* graph, bool bDecreasing, vector<uint>& vOrder) {
+	const uint numOfNodes = graph->numOfNodes;
+	uint64_t maxDegree = 0;
+	for (uint v = 0; v < numOfNodes; v++)
+		maxDegree = max(maxDegree, graph->degree(v));
+	vector<uint> vFirst(maxDegree + 2, 0);
+	for (uint v = 0; v < numOfNodes; v++)
+		vFirst[(bDecreasing ? maxDegree - graph->degree(v) : graph->degree(v)) + 1]++;
+	for (uint64_t d = 0; d <= maxDegree; d++)
+		vFirst[d+1] += vFirst[d];
+	vOrder.resize(numOfNodes);
+	for (uint v = 0; v < numOfNodes; v++)
+		vOrder[vFirst[bDecreasing ? maxDegree - graph->degree(v) : graph->degree(v)]++] = v;
+}
+
+/*
+ * Breadth first from every vertex of vStarts not reached yet, in that
+ * order, so every component is covered. bByDegree takes the new neighbours
+ * of a vertex by increasing degree, ties by id, as Cuthill-McKee does.
+ */
+static void breadthFirst(const sGraph* graph, const vector<uint>& vStarts, bool bByDegree, vector<uint>& vOrder) {
+	const uint numOfNodes = graph->numOfNodes;
+	vector<bool> vSeen(numOfNodes, false);
+	vOrder.clear();
+	vOrder.reserve(numOfNodes);
+	for (size_t s = 0; s < vStarts.size(); s++) {
+		if (vSeen[vStarts[s]])
+			continue;
+		vSeen[vStarts[s]] = true;
+		vOrder.push_back(vStarts[s]);
+		for (size_t i = vOrder.size() - 1; i < vOrder.size(); i++) {
+			const uint v = vOrder[i];
+			const size_t first = vOrder.size();
+			for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++) {
+				const uint w = graph->adjVertex[e];
+				if (!vSeen[w]) {
+					vSeen[w] = true;
+					vOrder.push_back(w);
+				}
+			}
+			if (bByDegree && vOrder.size() - first > 1)
+				sort(vOrder.begin() + first, vOrder.end(), [graph](uint a, uint b) {
+					return graph->degree(a) < graph->degree(b) || (graph->degree(a) == graph->degree(b) && a < b);
+				});
+		}
+	}
+}
+
+/*
+ * Computes the new vertex order, vOrder[i] is the vertex that gets id i
+ */
+void computeOrder(const sGraph* graph, eReorder reorder, vector<uint>& vOrder) {
+	vector<uint> vStarts;
+	switch (reorder) {
+	case REORDER_BFS:
+		vStarts.resize(graph->numOfNodes);
+		for (uint v = 0; v < graph->numOfNodes; v++)
+			vStarts[v] = v;
+		breadthFirst(graph, vStarts, false, vOrder);
+		break;
+	case REORDER_RCM:
+		// Lowest degree vertex of every component first
+		sortByDegree(graph, false, vStarts);
+		breadthFirst(graph, vStarts, true, vOrder);
+		reverse(vOrder.begin(), vOrder.end());
+		break;
+	case REORDER_DEGREE:
+		sortByDegree(graph, true, vOrder);
+		break;
+	default:
+		vOrder.resize(graph->numOfNodes);
+		for (uint v = 0; v < graph->numOfNodes; v++)
+			vOrder[v] = v;
+	}
+}
+
+/*
+ * Builds the graph with vertex vOrder[i] renamed to i, the rows keep the
+ * order of the graph and the costs their width. The rows are read in the
+ * old order, so only the new ids of the neighbours are looked up at random.
+ */
+void permuteGraph(const sGraph* graph, const vector<uint>& vOrder, uint numOfThreads, sGraph* permuted) {
+	const uint numOfNodes = graph->numOfNodes;
+	const bool bNarrow = graph->costType == COST_UINT16;
+	vector<uint> vNewId(numOfNodes);
+	for (uint i = 0; i < numOfNodes; i++)
+		vNewId[vOrder[i]] = i;
+
+	releaseGraph(permuted);
+	vector<uint64_t>& offsets = permuted->vOffsets;
+	offsets.assign(numOfNodes + 1, 0);
+	for (uint i = 0; i < numOfNodes; i++)
+		offsets[i+1] = offsets[i] + graph->degree(vOrder[i]);
+	vector<uint>& vAdjVertex = permuted->vAdjVertex;
+	vAdjVertex.resize(offsets[numOfNodes]);
+	if (bNarrow)
+		permuted->vAdjCost16.resize(offsets[numOfNodes]);
+	else
+		permuted->vAdjCost.resize(offsets[numOfNodes]);
+
+	parallelFor(numOfThreads, numOfNodes, [&](uint, size_t begin, size_t end) {
+		for (size_t v = begin; v < end; v++) {
+			const uint64_t first = graph->offsets[v], last = graph->offsets[v+1];
+			const uint64_t slot = offsets[vNewId[v]];
+			for (uint64_t e = first; e < last; e++)
+				vAdjVertex[slot + e - first] = vNewId[graph->adjVertex[e]];
+			if (bNarrow)
+				memcpy(&permuted->vAdjCost16[slot], &graph->adjCost16[first], (last - first) * sizeof(uint16_t));
+			else
+				memcpy(&permuted->vAdjCost[slot], &graph->adjCost[first], (last - first) * sizeof(int));
+		}
+	});
+	permuted->numOfNodes = numOfNodes;
+	permuted->numOfEdges = graph->numOfEdges;
+	permuted->costType = graph->costType;
+	attachOwnedArrays(permuted);
+}
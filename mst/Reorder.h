@@ -0,0 +1,34 @@
+/*
+ * Reorder.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef REORDER_H_
+#define REORDER_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+
+// Vertex renumbering done before a scheme runs
+enum eReorder {
+	REORDER_NONE,
+	// Breadth first order, neighbours get nearby ids
+	REORDER_BFS,
+	// Reverse Cuthill-McKee, breadth first from a low degree vertex with
+	// neighbours taken by increasing degree, then reversed
+	REORDER_RCM,
+	// Decreasing degree, the hubs share the first cache lines
+	REORDER_DEGREE
+};
+
+bool parseReorder(const string& name, eReorder* reorder);
+string reorderName(eReorder reorder);
+void computeOrder(const sGraph* graph, eReorder reorder, vector<uint>& vOrder);
+void permuteGraph(const sGraph* graph, const vector<uint>& vOrder, uint numOfThreads, sGraph* permuted);
+
+#endif /* REORDER_H_ */
@@ -0,0 +1,342 @@
+/*
+ * ResultCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ResultCache.h"
+
+#define HASH_PRIME1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME3 0x165667B19E3779F9ULL
+#define HASH_PRIME4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME5 0x27D4EB2F165667C5ULL
+// Seeds of the content hash and the entry checksum
+#define CONTENT_SEED 0
+#define CHECKSUM_SEED 0x6D7374
+
+// Entry file found by the eviction scan
+struct sCacheEntry {
+	string strPath;
+	uint64_t size;
+	struct timespec mtime;
+};
+
+static inline uint64_t rotateLeft(uint64_t x, int r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hashRound(uint64_t lane, uint64_t word) {
+	return rotateLeft(lane + word * HASH_PRIME2, 31) * HASH_PRIME1;
+}
+
+static inline uint64_t mergeLane(uint64_t hash, uint64_t lane) {
+	return (hash ^ hashRound(0, lane)) * HASH_PRIME1 + HASH_PRIME4;
+}
+
+/*
+ * 64-bit hash in the manner of xxHash64: four independent lanes take 32
+ * bytes per step, so the multiplies overlap and a file in the page cache
+ * hashes at several GB/s, which keeps a cache hit far below a parse.
+ */
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+	const uint8_t* p = (const uint8_t*)data;
+	const uint8_t* const end = p + size;
+	uint64_t hash, word;
+
+	if (size >= 32) {
+		uint64_t lanes[4] = { seed + HASH_PRIME1 + HASH_PRIME2, seed + HASH_PRIME2, seed, seed - HASH_PRIME1 };
+		for (; end - p >= 32; p += 32) {
+			for (int i = 0; i < 4; i++) {
+				memcpy(&word, p + 8 * i, sizeof(word));
+				lanes[i] = hashRound(lanes[i], word);
+			}
+		}
+		hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12)
+			+ rotateLeft(lanes[3], 18);
+		for (int i = 0; i < 4; i++)
+			hash = mergeLane(hash, lanes[i]);
+	} else {
+		hash = seed + HASH_PRIME5;
+	}
+	hash += size;
+	for (; end - p >= 8; p += 8) {
+		memcpy(&word, p, sizeof(word));
+		hash = rotateLeft(hash ^ hashRound(0, word), 27) * HASH_PRIME1 + HASH_PRIME4;
+	}
+	for (; p < end; p++)
+		hash = rotateLeft(hash ^ (*p * HASH_PRIME5), 11) * HASH_PRIME1;
+	hash ^= hash >> 33;
+	hash *= HASH_PRIME2;
+	hash ^= hash >> 29;
+	hash *= HASH_PRIME3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+static string hexString(uint64_t value) {
+	char text[17];
+	snprintf(text, sizeof(text), "%016llx", (unsigned long long)value);
+	return text;
+}
+
+/*
+ * The options that can change the tree, not just the time it takes: ties
+ * between equal costs are broken differently by every scheme and heap.
+ * The thread count is left out, the parallel schemes give the same tree
+ * whatever it is.
+ */
+static string optionsString(const sMstOptions& options) {
+	const char* schemes[] = { "simple", "heap", "kruskal", "boruvka", "dense" };
+	string strOptions = string("scheme=") + schemes[options.scheme];
+	if (options.scheme == HEAP_SCHEME)
+		strOptions += ",heap=" + options.strHeapName + ",insert=" + (options.bEagerInsert ? "eager" : "lazy")
+			+ ",bucket-limit=" + to_string(options.maxBucketKey);
+	if (options.scheme == KRUSKAL_SCHEME && options.bFilterKruskal)
+		strOptions += ",filter";
+	if (options.bForest)
+		strOptions += ",forest";
+	if (options.reorder != REORDER_NONE)
+		strOptions += ",reorder=" + reorderName(options.reorder);
+	// Padded so the arrays after it in an entry stay aligned
+	strOptions.resize((strOptions.size() + 7) & ~(size_t)7, '\0');
+	return strOptions;
+}
+
+/*
+ * Hashes the graph file, whatever its format, and names the cache entry
+ * of its tree under options. The file is mapped and read once, sequentially.
+ */
+bool makeCacheKey(const string& fileName, const sMstOptions& options, sCacheKey* key) {
+	struct stat st;
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		cout << "Unable to open file \"" << fileName << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	if (fstat(fd, &st) != 0) {
+		cout << "Unable to read file \"" << fileName << "\"" << endl;
+		close(fd);
+		return EXIT_FAILURE;
+	}
+	key->fileSize = st.st_size;
+	if (st.st_size == 0) {
+		key->contentHash = hashBytes(NULL, 0, CONTENT_SEED);
+	} else {
+		void* base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (base == MAP_FAILED) {
+			cout << "Unable to map file \"" << fileName << "\"" << endl;
+			close(fd);
+			return EXIT_FAILURE;
+		}
+		madvise(base, st.st_size, MADV_SEQUENTIAL);
+		key->contentHash = hashBytes(base, st.st_size, CONTENT_SEED);
+		munmap(base, st.st_size);
+	}
+	close(fd);
+	key->strOptions = optionsString(options);
+	key->strName = hexString(key->contentHash) + "-"
+		+ hexString(hashBytes(key->strOptions.data(), key->strOptions.size(), key->fileSize)) + ".mst";
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Reads the entry of key into result. Returns EXIT_FAILURE, silently, on
+ * a miss and on an entry that doesn't check out, which the store after the
+ * miss replaces. A hit marks the entry as recently used by setting its
+ * modification time, which is what eviction goes by.
+ */
+bool lookupCache(const sResultCache& cache, const sCacheKey& key, sMstResult* result) {
+	const string strPath = cache.strDir + "/" + key.strName;
+	struct stat st;
+	sCacheHeader header;
+
+	int fd = open(strPath.c_str(), O_RDONLY);
+	if (fd < 0)
+		return EXIT_FAILURE;
+	// The counts are bounded by the vertex count first, so the size can't overflow
+	bool bValid = fstat(fd, &st) == 0 && (uint64_t)st.st_size >= sizeof(header)
+		&& pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)
+		&& !memcmp(header.magic, RESULT_CACHE_MAGIC, sizeof(header.magic))
+		&& header.version == RESULT_CACHE_VERSION && header.optionsSize == key.strOptions.size()
+		&& header.contentHash == key.contentHash && header.fileSize == key.fileSize
+		&& header.numOfNodes <= UINT_MAX && header.numOfEdges <= header.numOfNodes
+		&& header.numOfComponents <= header.numOfNodes
+		&& (uint64_t)st.st_size == sizeof(header) + header.optionsSize
+			+ header.numOfComponents * sizeof(sMstComponent) + header.numOfEdges * sizeof(sCacheEdge)
+			+ header.detailsSize;
+	vector<char> vPayload;
+	if (bValid) {
+		vPayload.resize(st.st_size - sizeof(header));
+		bValid = pread(fd, vPayload.data(), vPayload.size(), sizeof(header)) == (ssize_t)vPayload.size()
+			&& hashBytes(vPayload.data(), vPayload.size(), CHECKSUM_SEED) == header.checksum
+			&& !memcmp(vPayload.data(), key.strOptions.data(), header.optionsSize);
+	}
+	if (!bValid) {
+		close(fd);
+		return EXIT_FAILURE;
+	}
+	futimens(fd, NULL);
+	close(fd);
+
+	const char* p = vPayload.data() + header.optionsSize;
+	result->clear();
+	result->vComponents.resize(header.numOfComponents);
+	memcpy(result->vComponents.data(), p, header.numOfComponents * sizeof(sMstComponent));
+	p += header.numOfComponents * sizeof(sMstComponent);
+	result->vEdges.resize(header.numOfEdges);
+	for (uint64_t i = 0; i < header.numOfEdges; i++, p += sizeof(sCacheEdge)) {
+		sCacheEdge stored;
+		memcpy(&stored, p, sizeof(stored));
+		result->vEdges[i].vertexStart = stored.vertexStart;
+		result->vEdges[i].vertexEnd = stored.vertexEnd;
+		result->vEdges[i].cost = stored.cost;
+	}
+	result->strDetails.assign(p, header.detailsSize);
+	result->totalCost = header.totalCost;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Drops the least recently used entries until the directory fits in the
+ * size bound, and temporary files of writers that died. Only one process
+ * evicts at a time, the others skip it, since one pass serves them all.
+ * Readers may still hold a removed entry open, they read it to the end.
+ */
+static void evictCacheEntries(const sResultCache& cache) {
+	const string strLock = cache.strDir + "/" + RESULT_CACHE_LOCK_FILE;
+	int lockFd = open(strLock.c_str(), O_RDWR | O_CREAT, 0644);
+	if (lockFd < 0)
+		return;
+	if (flock(lockFd, LOCK_EX | LOCK_NB) != 0) {
+		close(lockFd);
+		return;
+	}
+
+	vector<sCacheEntry> vEntries;
+	uint64_t totalSize = 0;
+	const time_t now = time(NULL);
+	DIR* dir = opendir(cache.strDir.c_str());
+	if (dir) {
+		struct dirent* item;
+		while ((item = readdir(dir)) != NULL) {
+			const string strName = item->d_name;
+			const bool bEntry = strName.size() > 4 && strName.compare(strName.size() - 4, 4, ".mst") == 0;
+			const bool bTemporary = strName.compare(0, 4, "tmp.") == 0;
+			struct stat st;
+			sCacheEntry entry;
+			entry.strPath = cache.strDir + "/" + strName;
+			if ((!bEntry && !bTemporary) || stat(entry.strPath.c_str(), &st) != 0)
+				continue;
+			if (bTemporary) {
+				if (now - st.st_mtime > RESULT_CACHE_STALE_TIME)
+					unlink(entry.strPath.c_str());
+				continue;
+			}
+			entry.size = st.st_size;
+			entry.mtime = st.st_mtim;
+			totalSize += entry.size;
+			vEntries.push_back(entry);
+		}
+		closedir(dir);
+	}
+	if (totalSize > cache.maxBytes) {
+		sort(vEntries.begin(), vEntries.end(), [](const sCacheEntry& a, const sCacheEntry& b) {
+			return a.mtime.tv_sec != b.mtime.tv_sec ? a.mtime.tv_sec < b.mtime.tv_sec : a.mtime.tv_nsec < b.mtime.tv_nsec;
+		});
+		for (size_t i = 0; i < vEntries.size() && totalSize > cache.maxBytes; i++) {
+			// Someone else may have removed it already
+			if (unlink(vEntries[i].strPath.c_str()) == 0 || errno == ENOENT)
+				totalSize -= vEntries[i].size;
+		}
+	}
+	flock(lockFd, LOCK_UN);
+	close(lockFd);
+}
+
+static bool writeAll(int fd, const void* data, size_t size) {
+	const char* p = (const char*)data;
+	while (size > 0) {
+		const ssize_t written = write(fd, p, size);
+		if (written <= 0)
+			return EXIT_FAILURE;
+		p += written;
+		size -= written;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Stores the tree of result under key. The entry is written to a temporary
+ * file and renamed into place, so other processes see either no entry or
+ * the whole of it. Two processes storing the same key write the same entry.
+ */
+bool storeCache(const sResultCache& cache, const sCacheKey& key, uint numOfNodes, const sMstResult& result) {
+	sCacheHeader header;
+	const uint64_t componentsSize = result.vComponents.size() * sizeof(sMstComponent);
+	vector<char> vPayload(key.strOptions.size() + componentsSize + result.vEdges.size() * sizeof(sCacheEdge)
+		+ result.strDetails.size());
+
+	if (mkdir(cache.strDir.c_str(), 0755) != 0 && errno != EEXIST) {
+		cout << "Unable to create cache directory \"" << cache.strDir << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	if (sizeof(header) + vPayload.size() > cache.maxBytes)
+		return EXIT_SUCCESS;
+
+	char* p = vPayload.data();
+	memcpy(p, key.strOptions.data(), key.strOptions.size());
+	p += key.strOptions.size();
+	memcpy(p, result.vComponents.data(), componentsSize);
+	p += componentsSize;
+	for (size_t i = 0; i < result.vEdges.size(); i++, p += sizeof(sCacheEdge)) {
+		const sCacheEdge stored = { (uint32_t)result.vEdges[i].vertexStart, (uint32_t)result.vEdges[i].vertexEnd,
+			result.vEdges[i].cost };
+		memcpy(p, &stored, sizeof(stored));
+	}
+	memcpy(p, result.strDetails.data(), result.strDetails.size());
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, RESULT_CACHE_MAGIC, sizeof(header.magic));
+	header.version = RESULT_CACHE_VERSION;
+	header.optionsSize = key.strOptions.size();
+	header.contentHash = key.contentHash;
+	header.fileSize = key.fileSize;
+	header.numOfNodes = numOfNodes;
+	header.numOfEdges = result.vEdges.size();
+	header.numOfComponents = result.vComponents.size();
+	header.totalCost = result.totalCost;
+	header.detailsSize = result.strDetails.size();
+	header.checksum = hashBytes(vPayload.data(), vPayload.size(), CHECKSUM_SEED);
+
+	string strTemp = cache.strDir + "/tmp.XXXXXX";
+	int fd = mkstemp(&strTemp[0]);
+	if (fd < 0) {
+		cout << "Unable to write to cache directory \"" << cache.strDir << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	bool bFailed = writeAll(fd, &header, sizeof(header)) || writeAll(fd, vPayload.data(), vPayload.size());
+	fchmod(fd, 0644);
+	if (close(fd) != 0)
+		bFailed = true;
+	const string strPath = cache.strDir + "/" + key.strName;
+	if (bFailed || rename(strTemp.c_str(), strPath.c_str()) != 0) {
+		unlink(strTemp.c_str());
+		cout << "Unable to write cache entry \"" << strPath << "\"" << endl;
+		return EXIT_FAILURE;
+	}
+	evictCacheEntries(cache);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/*
+ * ResultCache.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef RESULTCACHE_H_
+#define RESULTCACHE_H_
+
+#include <string>
+#include <stdint.h>
+#include "Global.h"
+#include "MstSolver.h"
+
+#define RESULT_CACHE_MAGIC "MSTRES\r\n"
+#define RESULT_CACHE_VERSION 2
+// Size bound of a cache directory in MB unless --cache-size gives one
+#define RESULT_CACHE_DEFAULT_SIZE 1024
+// Temporary entries older than this in seconds were left by a writer that died
+#define RESULT_CACHE_STALE_TIME 3600
+// Taken while a process evicts entries, see evictCacheEntries
+#define RESULT_CACHE_LOCK_FILE "lock"
+
+/*
+ * Result cache entry, one file per graph content and options named
+ * <contentHash>-<optionsHash>.mst (host byte order):
+ *
+ *   sCacheHeader
+ *   options     char[optionsSize], NUL padded to a multiple of 8
+ *   components  sMstComponent[numOfComponents], forest mode only
+ *   edges       sCacheEdge[numOfEdges]
+ *   details     char[detailsSize]
+ *
+ * The edges are those of the result in the order and orientation the
+ * scheme gave them, and details is its strDetails, so a hit reports the
+ * same tree the same way the miss did. checksum covers everything after
+ * the header, so a torn or corrupt entry reads as a miss.
+ */
+struct sCacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t optionsSize;
+	uint64_t contentHash;
+	uint64_t fileSize;
+	uint64_t numOfNodes;
+	uint64_t numOfEdges;
+	uint64_t numOfComponents;
+	int64_t totalCost;
+	uint64_t checksum;
+	uint32_t detailsSize;
+	uint32_t reserved;
+};
+
+// Tree edge as an entry stores it
+struct sCacheEdge {
+	uint32_t vertexStart;
+	uint32_t vertexEnd;
+	int32_t cost;
+};
+
+// Cache directory and its size bound given by --cache and --cache-size
+struct sResultCache {
+	// Empty means no cache
+	string strDir;
+	uint64_t maxBytes;
+
+	sResultCache():
+		maxBytes((uint64_t)RESULT_CACHE_DEFAULT_SIZE << 20) {}
+};
+
+// What a result is cached under: the graph content and the options that shape the tree
+struct sCacheKey {
+	uint64_t contentHash;
+	uint64_t fileSize;
+	string strOptions;
+	// Entry file name within the cache directory
+	string strName;
+
+	sCacheKey():
+		contentHash(0),fileSize(0) {}
+};
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed);
+bool makeCacheKey(const string& fileName, const sMstOptions& options, sCacheKey* key);
+bool lookupCache(const sResultCache& cache, const sCacheKey& key, sMstResult* result);
+bool storeCache(const sResultCache& cache, const sCacheKey& key, uint numOfNodes, const sMstResult& result);
+
+#endif /* RESULTCACHE_H_ */
@@ -0,0 +1,229 @@
+/*
+ * SpanningForest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <mutex>
+#include "SpanningForest.h"
+#include "DisjointSet.h"
+#include "Parallel.h"
+
+// Scratch state of one thread of the forest scheme, reused from component
+// to component
+struct sForestWorker {
+	// View of the component in the laid out arrays, owns nothing
+	sGraph graph;
+	sWorkspace workspace;
+	sMstResult result;
+	// Reordering time of the components this worker solved
+	long rtime;
+
+	sForestWorker():
+		rtime(0) {}
+};
+
+/*
+ * Labels the connected components of the graph. The edges are merged in
+ * parallel with the lock free union-find, which keeps the smallest vertex
+ * of every set as its root, so a single pass over the vertices numbers the
+ * components in the order of their smallest vertex.
+ */
+void findComponents(const sGraph* graph, uint numOfThreads, sComponents* components) {
+	const uint numOfNodes = graph->numOfNodes;
+	sConcurrentDisjointSet sets(numOfNodes);
+	parallelFor(numOfThreads, numOfNodes, [&](uint, size_t begin, size_t end) {
+		for (size_t v = begin; v < end; v++)
+			for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++)
+				if (v < graph->adjVertex[e])
+					sets.unite(v, graph->adjVertex[e]);
+	});
+
+	vector<uint>& vLabels = components->vLabels;
+	vector<uint>& vLocal = components->vLocal;
+	vector<uint>& vFirst = components->vFirst;
+	vLabels.resize(numOfNodes);
+	vLocal.resize(numOfNodes);
+	vFirst.clear();
+	// vFirst counts the vertices of every component first
+	for (uint v = 0; v < numOfNodes; v++) {
+		const uint root = sets.find(v);
+		if (root == v) {
+			vLabels[v] = vFirst.size();
+			vFirst.push_back(0);
+		} else {
+			vLabels[v] = vLabels[root];
+		}
+		vLocal[v] = vFirst[vLabels[v]]++;
+	}
+	components->numOfComponents = vFirst.size();
+	vFirst.push_back(0);
+	for (uint c = 0, first = 0; c <= components->numOfComponents; c++) {
+		const uint count = vFirst[c];
+		vFirst[c] = first;
+		first += count;
+	}
+	components->vVertices.resize(numOfNodes);
+	for (uint v = 0; v < numOfNodes; v++)
+		components->vVertices[vFirst[vLabels[v]] + vLocal[v]] = v;
+}
+
+/* Algorithm :
+		1.	Find the connected components with a parallel union-find.
+		2.	A connected graph is solved as it is. Otherwise lay every component
+			out as a CSR graph of its own with local vertex ids, one after the
+			other in a single set of arrays.
+		3.	Components holding more than an even share of the vertices are
+			solved first, one after the other, with every thread. The rest run
+			side by side on a work stealing pool, one thread each, largest first.
+		4.	Map the tree edges of every component back to the graph's vertex ids.
+			The edges of component c go to their own slots of the result, so the
+			threads never write to the same place.
+*/
+bool generateMSTForestScheme(const sGraph* graph, const sMstOptions& options, uint numOfThreads,
+		sMstResult* result) {
+	const uint numOfNodes = graph->numOfNodes;
+	struct timeval start, end;
+	long seconds, useconds;
+	sComponents components;
+	sMstOptions componentOptions = options;
+	componentOptions.bForest = false;
+	componentOptions.numOfThreads = numOfThreads;
+
+	gettimeofday(&start, NULL);
+	findComponents(graph, numOfThreads, &components);
+	const uint numOfComponents = components.numOfComponents;
+	const vector<uint>& vFirst = components.vFirst;
+	const vector<uint>& vVertices = components.vVertices;
+
+	if (numOfComponents == 1) {
+		if (solveMst(graph, componentOptions, NULL, result))
+			return EXIT_FAILURE;
+		sMstComponent component = { 0, numOfNodes, 0, result->totalCost };
+		result->vComponents.push_back(component);
+		result->strDetails = "Components = 1\n" + result->strDetails;
+		gettimeofday(&end, NULL);
+		result->mtime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+		return EXIT_SUCCESS;
+	}
+
+	// Component c keeps its offsets at vOffsets[vFirst[c] + c], relative to
+	// its first adjacency entry vEdgeFirst[c]
+	vector<uint64_t> vEdgeFirst(numOfComponents + 1, 0);
+	vector<uint64_t> vOffsets(numOfNodes + numOfComponents);
+	for (uint v = 0; v < numOfNodes; v++)
+		vEdgeFirst[components.vLabels[v] + 1] += graph->degree(v);
+	for (uint c = 0; c < numOfComponents; c++)
+		vEdgeFirst[c+1] += vEdgeFirst[c];
+	// The components keep the cost width of the graph
+	const bool bNarrow = graph->costType == COST_UINT16;
+	vector<uint> vAdjVertex(vEdgeFirst[numOfComponents]);
+	vector<int> vAdjCost(bNarrow ? 0 : vEdgeFirst[numOfComponents]);
+	vector<uint16_t> vAdjCost16(bNarrow ? vEdgeFirst[numOfComponents] : 0);
+
+	parallelFor(numOfThreads, numOfComponents, [&](uint, size_t begin, size_t end) {
+		for (size_t c = begin; c < end; c++) {
+			uint64_t* offsets = &vOffsets[vFirst[c] + c];
+			uint64_t offset = 0;
+			for (uint i = vFirst[c]; i < vFirst[c+1]; i++) {
+				offsets[i - vFirst[c]] = offset;
+				offset += graph->degree(vVertices[i]);
+			}
+			offsets[vFirst[c+1] - vFirst[c]] = offset;
+		}
+	});
+	parallelFor(numOfThreads, numOfNodes, [&](uint, size_t begin, size_t end) {
+		for (size_t v = begin; v < end; v++) {
+			const uint c = components.vLabels[v];
+			uint64_t slot = vEdgeFirst[c] + vOffsets[vFirst[c] + c + components.vLocal[v]];
+			for (uint64_t e = graph->offsets[v]; e < graph->offsets[v+1]; e++, slot++) {
+				vAdjVertex[slot] = components.vLocal[graph->adjVertex[e]];
+				if (bNarrow)
+					vAdjCost16[slot] = graph->adjCost16[e];
+				else
+					vAdjCost[slot] = graph->adjCost[e];
+			}
+		}
+	});
+
+	// Every component of more than one vertex needs solving, largest first
+	vector<sMstComponent>& vComponents = result->vComponents;
+	vector<uint> vOrder;
+	uint largest = 0, isolated = 0;
+	vComponents.resize(numOfComponents);
+	for (uint c = 0; c < numOfComponents; c++) {
+		const uint size = vFirst[c+1] - vFirst[c];
+		sMstComponent component = { vVertices[vFirst[c]], size, vFirst[c] - c, 0 };
+		vComponents[c] = component;
+		largest = max(largest, size);
+		if (size > 1)
+			vOrder.push_back(c);
+		else
+			isolated++;
+	}
+	stable_sort(vOrder.begin(), vOrder.end(), [&](uint a, uint b) {
+		return vComponents[a].numOfNodes > vComponents[b].numOfNodes;
+	});
+	result->vEdges.resize(numOfNodes - numOfComponents);
+
+	vector<sForestWorker> vWorkers(numOfThreads);
+	mutex errorLock;
+	auto solveComponent = [&](sForestWorker& worker, uint c, const sMstOptions& solveOptions) {
+		sMstComponent& component = vComponents[c];
+		worker.graph.numOfNodes = component.numOfNodes;
+		worker.graph.numOfEdges = (vEdgeFirst[c+1] - vEdgeFirst[c]) / 2;
+		worker.graph.offsets = &vOffsets[vFirst[c] + c];
+		worker.graph.adjVertex = &vAdjVertex[vEdgeFirst[c]];
+		worker.graph.costType = graph->costType;
+		if (bNarrow)
+			worker.graph.adjCost16 = &vAdjCost16[vEdgeFirst[c]];
+		else
+			worker.graph.adjCost = &vAdjCost[vEdgeFirst[c]];
+		if (solveMst(&worker.graph, solveOptions, &worker.workspace, &worker.result)) {
+			lock_guard<mutex> guard(errorLock);
+			if (result->strError.empty())
+				result->strError = "Component " + to_string(c) + ": " + worker.result.strError;
+			return;
+		}
+		const uint* vLocalVertices = &vVertices[vFirst[c]];
+		sEdge* vTree = &result->vEdges[component.firstEdge];
+		for (size_t i = 0; i < worker.result.vEdges.size(); i++) {
+			vTree[i].vertexStart = vLocalVertices[worker.result.vEdges[i].vertexStart];
+			vTree[i].vertexEnd = vLocalVertices[worker.result.vEdges[i].vertexEnd];
+			vTree[i].cost = worker.result.vEdges[i].cost;
+		}
+		component.totalCost = worker.result.totalCost;
+		worker.rtime += worker.result.rtime;
+	};
+
+	// Components above an even share would leave the other threads idle
+	const uint share = numOfNodes / numOfThreads;
+	size_t numOfLarge = 0;
+	while (numOfLarge < vOrder.size() && vComponents[vOrder[numOfLarge]].numOfNodes > share)
+		solveComponent(vWorkers[0], vOrder[numOfLarge++], componentOptions);
+	componentOptions.numOfThreads = 1;
+	parallelJobs(numOfThreads, vOrder.size() - numOfLarge, [&](uint t, size_t j) {
+		solveComponent(vWorkers[t], vOrder[numOfLarge + j], componentOptions);
+	});
+
+	int64_t totalCost = 0;
+	for (uint c = 0; c < numOfComponents; c++)
+		totalCost += vComponents[c].totalCost;
+	for (uint t = 0; t < numOfThreads; t++)
+		result->rtime += vWorkers[t].rtime;
+	gettimeofday(&end, NULL);
+	seconds  = end.tv_sec  - start.tv_sec;
+	useconds = end.tv_usec - start.tv_usec;
+	result->mtime = ((seconds) * 1000000 + useconds) ;
+	result->totalCost = totalCost;
+	if (!result->strError.empty())
+		return EXIT_FAILURE;
+	result->strDetails = "Components = " + to_string(numOfComponents) + ", Largest = " + to_string(largest)
+		+ ", Isolated = " + to_string(isolated) + ", Threads = " + to_string(numOfThreads) + "\n";
+	if (options.reorder != REORDER_NONE)
+		result->strDetails += "Reorder = " + reorderName(options.reorder) + ", Reorder Time = "
+			+ to_string(result->rtime) + " microseconds\n";
+
+	return EXIT_SUCCESS;
+}
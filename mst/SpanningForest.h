@@ -0,0 +1,38 @@
+/*
+ * SpanningForest.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef SPANNINGFOREST_H_
+#define SPANNINGFOREST_H_
+
+#include <vector>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+
+/*
+ * Connected components of a graph, numbered in the order of their smallest
+ * vertex. The vertices of component c are vVertices[vFirst[c] .. vFirst[c+1])
+ * in increasing order, vLocal gives the position of a vertex in its
+ * component.
+ */
+struct sComponents {
+	uint numOfComponents;
+	vector<uint> vLabels;
+	vector<uint> vLocal;
+	vector<uint> vFirst;
+	vector<uint> vVertices;
+
+	sComponents():
+		numOfComponents(0) {}
+};
+
+void findComponents(const sGraph* graph, uint numOfThreads, sComponents* components);
+bool generateMSTForestScheme(const sGraph* graph, const sMstOptions& options, uint numOfThreads,
+		sMstResult* result);
+
+#endif /* SPANNINGFOREST_H_ */
@@ -0,0 +1,291 @@
+/*
+ * Verifier.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *  Author: Sagar
+ */
+#include <algorithm>
+#include <climits>
+#include <unordered_map>
+#include "Verifier.h"
+
+#define NO_PARENT UINT_MAX
+#define NO_QUERY UINT_MAX
+
+// Vertex state of the tree walk
+enum eVisit : uint8_t { VISIT_NEW, VISIT_OPEN, VISIT_DONE };
+
+// Graph edge whose check waits until the walk leaves the LCA of its end points
+struct sPathQuery {
+	uint u;
+	uint v;
+	int cost;
+	uint next;
+};
+
+/*
+ * Everything the walk keeps about a vertex, in one place since the graph
+ * edges reach the vertices in no particular order and each of them needs
+ * most of it.
+ */
+struct sPathNode {
+	// Union-find link and the most expensive tree edge between the vertex and it
+	uint link;
+	int maxUp;
+	// Tree parent and the cost of the edge to it
+	uint parent;
+	int parentCost;
+	// First graph edge waiting for the walk to leave this vertex
+	uint queryHead;
+	eVisit state;
+	// Set once the edge to the parent is found in the graph with its cost
+	bool bFound;
+};
+
+/*
+ * Union-find along the tree for the path maxima. A vertex is linked to its
+ * tree parent once the walk leaves it, so the root of a walked vertex is its
+ * lowest ancestor the walk hasn't left yet. Path compression keeps maxUp up
+ * to date as the links get shorter.
+ */
+struct sPathMax {
+	vector<sPathNode> nodes;
+	vector<uint> vPath;
+
+	explicit sPathMax(uint n):
+		nodes(n) {
+		for (uint i = 0; i < n; i++) {
+			sPathNode node = { i, INT_MIN, NO_PARENT, 0, NO_QUERY, VISIT_NEW, false };
+			nodes[i] = node;
+		}
+	}
+
+	// Returns the root of v, after it maxUp of v covers the path up to the root
+	uint find(uint v) {
+		uint root = nodes[v].link;
+		if (nodes[root].link == root)
+			return root;
+		vPath.clear();
+		vPath.push_back(v);
+		while (nodes[root].link != root) {
+			vPath.push_back(root);
+			root = nodes[root].link;
+		}
+		// Top down, so the link of each vertex already holds its maximum to the root
+		for (size_t i = vPath.size(); i-- > 0; ) {
+			sPathNode& node = nodes[vPath[i]];
+			if (node.link != root) {
+				node.maxUp = max(node.maxUp, nodes[node.link].maxUp);
+				node.link = root;
+			}
+		}
+		return root;
+	}
+
+	// Most expensive tree edge between v and its root, INT_MIN for the root itself
+	inline int pathMax(uint v) {
+		return find(v) == v ? INT_MIN : nodes[v].maxUp;
+	}
+};
+
+static void recordViolation(sVerifyResult* verify, uint u, uint v, int cost, int treeMax) {
+	if (verify->numOfViolations++ == 0)
+		verify->strError = "Not minimum: edge " + to_string(u) + "-" + to_string(v) + " of cost "
+			+ to_string(cost) + " is cheaper than the tree edge of cost " + to_string(treeMax)
+			+ " on the tree path between its end points";
+}
+
+/*
+ * Checks that the edges of result form a minimum spanning forest of the
+ * graph in O(m a(m, n)) time, following Tarjan's offline LCA:
+ *
+ *   - the edges are in range, add up to result.totalCost and form no cycle
+ *   - every tree edge is an edge of the graph with the same cost
+ *   - no graph edge joins two trees, so every tree spans its component
+ *   - unless bForest, there is a single tree: a disconnected graph has no
+ *     spanning tree, only a spanning forest
+ *   - no graph edge is cheaper than the most expensive tree edge on the
+ *     tree path between its end points, the cycle property of an MST
+ *
+ * The last check is answered for all graph edges in one post-order walk of
+ * the tree. When the walk leaves vertex x, each graph edge x-y to a vertex
+ * y left before is handled: the root of y in sPathMax is their LCA. The
+ * path maxima on both sides of the LCA are known once the walk leaves the
+ * LCA, so the edge waits in the LCA's query list until then, unless the
+ * LCA is x itself. Tree edges pass the check with their own cost.
+ *
+ * Returns EXIT_FAILURE with the first problem in verify->strError if the
+ * tree is not a minimum spanning forest.
+ */
+bool verifyMst(const sGraph* graph, const sMstResult& result, bool bForest, sVerifyResult* verify) {
+	struct timeval start, end;
+	const uint numOfNodes = graph->numOfNodes;
+	const vector<sEdge>& vEdges = result.vEdges;
+
+	*verify = sVerifyResult();
+	gettimeofday(&start, NULL);
+
+	// Edges in range, tree adjacency in CSR form
+	vector<uint64_t> vOffsets(numOfNodes + 1, 0);
+	int64_t totalCost = 0;
+	for (size_t i = 0; i < vEdges.size(); i++) {
+		const uint u = vEdges[i].vertexStart, v = vEdges[i].vertexEnd;
+		if (u >= numOfNodes || v >= numOfNodes || u == v) {
+			verify->strError = "Tree edge " + to_string(vEdges[i].vertexStart) + "-" + to_string(vEdges[i].vertexEnd)
+				+ " doesn't join two vertices of the graph";
+			return EXIT_FAILURE;
+		}
+		vOffsets[u+1]++;
+		vOffsets[v+1]++;
+		totalCost += vEdges[i].cost;
+	}
+	if (totalCost != result.totalCost) {
+		verify->strError = "TotalCost is " + to_string(result.totalCost) + " but the tree edges add up to "
+			+ to_string(totalCost);
+		return EXIT_FAILURE;
+	}
+	for (uint v = 0; v < numOfNodes; v++)
+		vOffsets[v+1] += vOffsets[v];
+	vector<uint> vTreeVertex(2 * vEdges.size());
+	vector<int> vTreeCost(2 * vEdges.size());
+	{
+		vector<uint64_t> vFill(vOffsets.begin(), vOffsets.end() - 1);
+		for (size_t i = 0; i < vEdges.size(); i++) {
+			const uint u = vEdges[i].vertexStart, v = vEdges[i].vertexEnd;
+			vTreeVertex[vFill[u]] = v;
+			vTreeCost[vFill[u]++] = vEdges[i].cost;
+			vTreeVertex[vFill[v]] = u;
+			vTreeCost[vFill[v]++] = vEdges[i].cost;
+		}
+	}
+
+	sPathMax paths(numOfNodes);
+	vector<sPathNode>& nodes = paths.nodes;
+	vector<uint64_t> vNext(numOfNodes);
+	vector<uint> vStack;
+	vector<sPathQuery> vQueries;
+	bool bSpanning = true;
+
+	for (uint root = 0; root < numOfNodes && bSpanning; root++) {
+		if (nodes[root].state != VISIT_NEW)
+			continue;
+		verify->numOfTrees++;
+		nodes[root].state = VISIT_OPEN;
+		vNext[root] = vOffsets[root];
+		vStack.push_back(root);
+		while (!vStack.empty() && bSpanning) {
+			const uint x = vStack.back();
+			if (vNext[x] < vOffsets[x+1]) {
+				const uint64_t t = vNext[x]++;
+				sPathNode& child = nodes[vTreeVertex[t]];
+				if (child.state == VISIT_NEW) {
+					child.state = VISIT_OPEN;
+					child.parent = x;
+					child.parentCost = vTreeCost[t];
+					vNext[vTreeVertex[t]] = vOffsets[vTreeVertex[t]];
+					vStack.push_back(vTreeVertex[t]);
+				}
+				continue;
+			}
+			// Leaving x, its subtree is linked below it
+			vStack.pop_back();
+			nodes[x].state = VISIT_DONE;
+			for (uint64_t e = graph->offsets[x]; e < graph->offsets[x+1]; e++) {
+				const uint y = graph->adjVertex[e];
+				sPathNode& node = nodes[y];
+				if (node.state != VISIT_DONE || y == x)
+					continue;
+				const int cost = graph->cost(e);
+				verify->numOfChecked++;
+				if (node.parent == x && node.parentCost == cost)
+					node.bFound = true;
+				const uint lca = paths.find(y);
+				if (lca == x) {
+					const int treeMax = node.maxUp;
+					if (cost < treeMax)
+						recordViolation(verify, x, y, cost, treeMax);
+				} else if (nodes[lca].state == VISIT_OPEN) {
+					sPathQuery query = { x, y, cost, nodes[lca].queryHead };
+					nodes[lca].queryHead = vQueries.size();
+					vQueries.push_back(query);
+				} else {
+					// The root of y is the root of a tree left before
+					verify->strError = "Not spanning: graph edge " + to_string(x) + "-" + to_string(y)
+						+ " joins two trees";
+					bSpanning = false;
+					break;
+				}
+			}
+			for (uint q = nodes[x].queryHead; q != NO_QUERY; q = vQueries[q].next) {
+				const sPathQuery& query = vQueries[q];
+				const int treeMax = max(paths.pathMax(query.u), paths.pathMax(query.v));
+				if (query.cost < treeMax)
+					recordViolation(verify, query.u, query.v, query.cost, treeMax);
+			}
+			if (nodes[x].parent != NO_PARENT) {
+				nodes[x].link = nodes[x].parent;
+				nodes[x].maxUp = nodes[x].parentCost;
+			}
+		}
+	}
+
+	gettimeofday(&end, NULL);
+	verify->vtime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+
+	if (!bSpanning)
+		return EXIT_FAILURE;
+	// A forest of k trees has numOfNodes-k edges, any more close a cycle
+	if (vEdges.size() != numOfNodes - verify->numOfTrees) {
+		verify->strError = "The " + to_string(vEdges.size()) + " tree edges form a cycle, a forest of "
+			+ to_string(verify->numOfTrees) + " trees has " + to_string(numOfNodes - verify->numOfTrees) + " edges";
+		return EXIT_FAILURE;
+	}
+	if (!bForest && verify->numOfTrees != 1) {
+		verify->strError = "Not spanning: the tree edges form " + to_string(verify->numOfTrees)
+			+ " trees, the graph is not connected";
+		return EXIT_FAILURE;
+	}
+	for (uint v = 0; v < numOfNodes; v++) {
+		if (nodes[v].parent != NO_PARENT && !nodes[v].bFound) {
+			verify->strError = "Tree edge " + to_string(nodes[v].parent) + "-" + to_string(v) + " of cost "
+				+ to_string(nodes[v].parentCost) + " is not an edge of the graph";
+			return EXIT_FAILURE;
+		}
+	}
+	if (verify->numOfViolations) {
+		verify->strError += " (" + to_string(verify->numOfViolations) + " such edges)";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Fills in the costs of tree edges read without them, from the cheapest
+ * graph edge between the same end points. Edges that aren't in the graph
+ * keep their cost for verifyMst to report.
+ */
+void lookupTreeCosts(const sGraph* graph, vector<sEdge>& vEdges) {
+	unordered_map<uint64_t, size_t> vIndex;
+	vector<bool> vSeen(vEdges.size(), false);
+
+	vIndex.reserve(vEdges.size());
+	for (size_t i = 0; i < vEdges.size(); i++) {
+		const uint u = min(vEdges[i].vertexStart, vEdges[i].vertexEnd);
+		const uint v = max(vEdges[i].vertexStart, vEdges[i].vertexEnd);
+		vIndex[(uint64_t)u << 32 | v] = i;
+	}
+	for (uint u = 0; u < graph->numOfNodes; u++) {
+		for (uint64_t e = graph->offsets[u]; e < graph->offsets[u+1]; e++) {
+			const uint v = graph->adjVertex[e];
+			if (v <= u)
+				continue;
+			unordered_map<uint64_t, size_t>::const_iterator it = vIndex.find((uint64_t)u << 32 | v);
+			if (it == vIndex.end())
+				continue;
+			sEdge& edge = vEdges[it->second];
+			if (!vSeen[it->second] || graph->cost(e) < edge.cost)
+				edge.cost = graph->cost(e);
+			vSeen[it->second] = true;
+		}
+	}
+}
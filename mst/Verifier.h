@@ -0,0 +1,38 @@
+/*
+ * Verifier.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: sagar
+ */
+
+#ifndef VERIFIER_H_
+#define VERIFIER_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Global.h"
+#include "Graph.h"
+#include "MstSolver.h"
+
+// What verifyMst found out about a candidate tree
+struct sVerifyResult {
+	// Trees of the candidate, 1 for a spanning tree of a connected graph
+	uint numOfTrees;
+	// Graph edges checked against the most expensive tree edge on their path
+	uint64_t numOfChecked;
+	// Graph edges cheaper than that tree edge, the tree isn't minimum if any
+	uint64_t numOfViolations;
+	// Time the verification took in microseconds
+	long vtime;
+	// First problem found, empty if the tree is a minimum spanning forest
+	string strError;
+
+	sVerifyResult():
+		numOfTrees(0),numOfChecked(0),numOfViolations(0),vtime(0) {}
+};
+
+bool verifyMst(const sGraph* graph, const sMstResult& result, bool bForest, sVerifyResult* verify);
+void lookupTreeCosts(const sGraph* graph, vector<sEdge>& vEdges);
+
+#endif /* VERIFIER_H_ */
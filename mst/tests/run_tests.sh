@@ -0,0 +1,149 @@
+#!/bin/bash
+# Regression graphs, run against a built mst: tests/run_tests.sh path/to/mst
+# Every case names a graph, a line the output must hold, the scheme and its options.
+DIR=$(dirname "$0")
+# The Eclipse build by default, wherever the script is run from
+MST=${1:-$DIR/../Default/mst}
+FAILED=0
+
+check() {
+	local graph=$1 expected=$2 scheme=$3
+	shift 3
+	local output path=$graph
+	# Graphs made by the tests themselves are given with their full path
+	[[ $graph == /* ]] || path=$DIR/$graph
+	output=$("$MST" $scheme "$path" "$@" --output summary 2>&1)
+	if ! grep -qxF "$expected" <<< "$output"; then
+		echo "FAIL: mst $scheme $graph $*, expected \"$expected\""
+		echo "$output"
+		FAILED=1
+	fi
+}
+
+# Same as check, the run has to fail as well
+check_fails() {
+	local graph=$1 expected=$2 scheme=$3
+	shift 3
+	local path=$graph
+	[[ $graph == /* ]] || path=$DIR/$graph
+	if "$MST" $scheme "$path" "$@" --output summary > /dev/null 2>&1; then
+		echo "FAIL: mst $scheme $graph $* succeeded"
+		FAILED=1
+	fi
+	check "$graph" "$expected" "$scheme" "$@"
+}
+
+# Costs spanning the whole int range, Kruskal's counting sort range wrapped
+check wide_costs.txt "TotalCost = -2147483643" -k
+check wide_costs.txt "TotalCost = -2147483643" -k --filter
+
+# A real cost of INT_MAX, the Prim schemes took it for an unreached vertex
+check int_max_cost.txt "TotalCost = 2147483647" -s
+check int_max_cost.txt "TotalCost = 2147483647" -f
+check int_max_cost.txt "TotalCost = 2147483647" -f --insert eager
+check int_max_cost.txt "TotalCost = 2147483647" -f --heap binary --insert eager
+check int_max_cost.txt "TotalCost = 2147483647" -f --heap bucket --insert eager
+check int_max_cost.txt "TotalCost = 2147483647" -k
+# The dense scheme keeps INT_MAX and INT_MAX-1 for its own keys, it took such
+# an edge for a missing one. It rejects them now and takes any lighter cost
+check dense_inf_cost.txt "Dense scheme takes costs below 2147483646. Use -f or -k for this graph" -d
+check dense_inf_cost.txt "TotalCost = 2147483646" -f
+check dense_max_cost.txt "TotalCost = -3" -d
+# Kruskal and Boruvka returned a spanning forest as if it were a tree
+check disconnected.txt "Graph is not connected, it has no spanning tree" -k
+check disconnected.txt "Graph is not connected, it has no spanning tree" -k --filter
+check disconnected.txt "Graph is not connected, it has no spanning tree" -b
+check disconnected.txt "TotalCost = 3" -k --forest
+check disconnected.txt "TotalCost = 3" -b --forest
+# External mode printed the forest of a disconnected graph and succeeded
+check_fails disconnected.txt "Graph is not connected, it has no spanning tree" --external
+check disconnected.txt "Graph is not connected, the tree is a forest of 2 trees" --external --forest
+# The minimum budget is the fixed buffers, not the vertices
+check_fails wide_costs.txt "Memory budget of 1 MB is too small, at least 4 MB are needed: 3584 KB of input, run and sort buffers for any graph and 1 KB for the union-find of 3 vertices" --external --memory 1
+check wide_costs.txt "TotalCost = -2147483643" --external --memory 4
+# External mode took a binary graph file for a text one
+"$MST" --convert "$DIR/wide_costs.txt" /tmp/mst_test_graph.$$.bin > /dev/null
+check /tmp/mst_test_graph.$$.bin "TotalCost = -2147483643" --external
+# A neighbour id past the last vertex was mapped and indexed with. The
+# adjacency of the 3 vertex graph starts at byte 192
+printf '\xff\xff\xff\x00' | dd of=/tmp/mst_test_graph.$$.bin bs=1 seek=192 conv=notrunc 2> /dev/null
+check_fails /tmp/mst_test_graph.$$.bin "Graph file \"/tmp/mst_test_graph.$$.bin\" has a neighbour out of range" -k
+rm -f /tmp/mst_test_graph.$$.bin
+# Compressed graphs give the cost of the text graph, the bit packed costs
+# keep the whole int range
+"$MST" --compress "$DIR/wide_costs.txt" /tmp/mst_test_graph.$$.cgr > /dev/null
+check /tmp/mst_test_graph.$$.cgr "TotalCost = -2147483643" -f
+check /tmp/mst_test_graph.$$.cgr "TotalCost = -2147483643" -k --filter
+check /tmp/mst_test_graph.$$.cgr "TotalCost = -2147483643" -b
+check /tmp/mst_test_graph.$$.cgr "TotalCost = -2147483643" --external
+"$MST" --compress "$DIR/../sample.txt" /tmp/mst_test_graph.$$.cgr > /dev/null
+check /tmp/mst_test_graph.$$.cgr "TotalCost = 22" -s
+check /tmp/mst_test_graph.$$.cgr "TotalCost = 22" -d
+"$MST" --compress "$DIR/disconnected.txt" /tmp/mst_test_graph.$$.cgr > /dev/null
+check /tmp/mst_test_graph.$$.cgr "TotalCost = 3" -k --forest
+rm -f /tmp/mst_test_graph.$$.cgr
+# A forest only verifies when --forest asked for one
+check disconnected.txt "Verified = no, Not spanning: the tree edges form 2 trees, the graph is not connected" --verify-tree "$DIR/disconnected_forest.txt"
+check disconnected.txt "Verified = yes, Trees = 2, Edges Checked = 2" --verify-tree "$DIR/disconnected_forest.txt" --forest
+check disconnected.txt "Verified = yes, Trees = 2, Edges Checked = 2" -k --forest --verify
+# A binary tree file's edge count sized the edge vector before it was read
+"$MST" -k "$DIR/wide_costs.txt" --output binary -o /tmp/mst_test_tree.$$ > /dev/null
+printf '\xff\xff\xff\xff\xff\xff\xff\x0f' | dd of=/tmp/mst_test_tree.$$ bs=1 seek=16 conv=notrunc 2> /dev/null
+check_fails wide_costs.txt "File \"/tmp/mst_test_tree.$$\": truncated, expected 1152921504606846975 edges" --verify-tree /tmp/mst_test_tree.$$
+rm -f /tmp/mst_test_tree.$$
+# Renumbering leaves the cost alone and maps the tree back to the original
+# ids, which --verify checks against the graph as read
+check ../sample.txt "TotalCost = 22" -k
+check ../sample.txt "TotalCost = 22" -f --reorder bfs
+check ../sample.txt "Verified = yes, Trees = 1, Edges Checked = 12" -s --reorder rcm --verify
+check ../sample.txt "Verified = yes, Trees = 1, Edges Checked = 12" -b --reorder degree --verify
+check wide_costs.txt "TotalCost = -2147483643" -k --reorder rcm
+# A delta batch deleting and raising tree edges, inserting a new one and
+# lowering a non-tree one ends on the tree of the edited graph
+printf -- "- 2 5\n= 0 1 20\n+ 0 6 1\n= 3 5 1\n" > /tmp/mst_test_delta.$$
+printf "7 12\n0 1 20\n1 2 9\n0 2 8\n1 3 8\n2 3 2\n3 4 7\n1 4 10\n3 5 1\n4 5 5\n4 6 6\n5 6 2\n0 6 1\n" > /tmp/mst_test_edited.$$
+check /tmp/mst_test_edited.$$ "TotalCost = 19" -k
+check ../sample.txt "TotalCost = 19" -f --delta /tmp/mst_test_delta.$$
+check ../sample.txt "TotalCost = 19" -b --delta /tmp/mst_test_delta.$$
+rm -f /tmp/mst_test_delta.$$ /tmp/mst_test_edited.$$
+# A cache hit rebuilt the tree in vertex order and without the scheme's details
+CACHE=/tmp/mst_test_cache.$$
+# Only the lines that tell a hit from a miss may differ
+cache_run() {
+	"$MST" "$@" --cache $CACHE | grep -v '^Cache = \|^Load Time = \|^Time Taken = \|^Output Time = '
+}
+for run in "$DIR/../sample.txt -b -t 2" "$DIR/disconnected.txt -k --forest --reorder bfs"; do
+	set -- $run
+	graph=$1 scheme=$2
+	shift 2
+	MISS=$(cache_run $scheme "$graph" "$@" -o $CACHE.miss)
+	HIT=$(cache_run $scheme "$graph" "$@" -o $CACHE.hit)
+	if [ "$MISS" != "$HIT" ] || ! cmp -s $CACHE.miss $CACHE.hit; then
+		echo "FAIL: mst $scheme $graph $* --cache, the hit differs from the miss"
+		diff <(echo "$MISS"; cat $CACHE.miss) <(echo "$HIT"; cat $CACHE.hit)
+		FAILED=1
+	fi
+done
+check ../sample.txt "TotalCost = 22" -k
+check ../sample.txt "TotalCost = 22" -b -t 2 --cache $CACHE
+check disconnected.txt "TotalCost = 3" -k --forest --reorder bfs --cache $CACHE
+rm -rf $CACHE $CACHE.miss $CACHE.hit
+# Batch results on the standard output are pure CSV, the loader's messages
+# go in their column and options of other schemes are rejected
+BATCH_OUTPUT=$(printf -- "-f $DIR/parallel_edges.txt\n-k $DIR/parallel_edges.txt --filter\n" > /tmp/mst_test_manifest.$$ \
+	&& "$MST" --batch /tmp/mst_test_manifest.$$ -t 2 2>/dev/null)
+if grep -qv '^job,\|^[0-9]*,".*",.*,ok,7,2,.*,"Dropped 1 parallel edges; Dropped 1 self loops"$' <<< "$BATCH_OUTPUT"; then
+	echo "FAIL: mst --batch wrote more than the CSV results"
+	echo "$BATCH_OUTPUT"
+	FAILED=1
+fi
+printf -- "-d $DIR/parallel_edges.txt --heap binary\n" > /tmp/mst_test_manifest.$$
+if "$MST" --batch /tmp/mst_test_manifest.$$ > /dev/null 2>&1; then
+	echo "FAIL: mst --batch took --heap on a -d job"
+	FAILED=1
+fi
+rm -f /tmp/mst_test_manifest.$$
+if [ $FAILED = 0 ]; then
+	echo "All tests passed"
+fi
+exit $FAILED